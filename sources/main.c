@@ -1,9 +1,13 @@
 #include <assert.h>  // assert
 #include <float.h>  // DECIMAL_DIG
 #include <math.h>  // pow, sin
+#include <pthread.h>  // pthread_*
 #include <stddef.h>  // size_t, NULL
-#include <stdio.h>  // fclose, fflush, fopen, fprintf, fscanf, printf, sprintf, sscanf, stderr, stdin, stdout, EOF, FILE
-#include <stdlib.h>  // free, malloc, EXIT_FAILURE, EXIT_SUCCESS
+#include <stdint.h>  // int64_t, uint32_t, uint64_t
+#include <stdio.h>  // fclose, feof, ferror, fflush, fgetc, fopen, fprintf, fread, fscanf, fwrite, printf, sprintf, sscanf, stderr, stdin, stdout, EOF, FILE
+#include <stdlib.h>  // calloc, free, malloc, posix_memalign, realloc, EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>  // memcpy
+#include <time.h>  // clock, CLOCKS_PER_SEC
 
 
 #ifdef WITH_OMP
@@ -14,6 +18,9 @@
 typedef double real_type;
 
 
+#define PI (3.141592653589793238462643383279502884)
+
+
 struct Mesh
 {
   real_type * points;
@@ -82,7 +89,7 @@ mesh_Destroy (struct Mesh * mesh)
 }
 
 
-inline size_t
+static inline size_t
 mesh_PointIndex (const struct Mesh * mesh, size_t time_point, size_t space_point)
 {
   assert (mesh != NULL);
@@ -91,7 +98,7 @@ mesh_PointIndex (const struct Mesh * mesh, size_t time_point, size_t space_point
 }
 
 
-inline real_type
+static inline real_type
 mesh_Get (const struct Mesh * mesh, size_t time_point, size_t space_point)
 {
   assert (mesh != NULL);
@@ -100,7 +107,7 @@ mesh_Get (const struct Mesh * mesh, size_t time_point, size_t space_point)
 }
 
 
-inline void
+static inline void
 mesh_Set (const struct Mesh * mesh, size_t time_point, size_t space_point, real_type new_value)
 {
   assert (mesh != NULL);
@@ -176,8 +183,11 @@ mesh_Write_File_Formatted_AtTimePoint (
 typedef real_type temperature_function_type (real_type);
 
 
+typedef real_type coefficient_function_type (real_type);
+
+
 /**
- * @brief ∂u/∂t = α∂²u/∂x²
+ * @brief ∂u/∂t = ∂/∂x(α(x)∂u/∂x) + q(x)g(t)
  * u(x, 0) = f(x)
  * u(0, t) = β₀
  * u(L, t) = β₁
@@ -199,15 +209,51 @@ struct Parameters
   real_type boundary_condition_1;
 
   /**
-   * @brief α
+   * @brief ε, absolute error bound of compressed output  (0 for lossless).
+   */
+  real_type compression_tolerance;
+
+  /**
+   * @brief α,  used when  `diffusivity_profile'  is  `NULL'.
    */
   real_type diffusivity;
 
+  /**
+   * @brief α(x),  optional.
+   */
+  coefficient_function_type * diffusivity_profile;
+
+  /**
+   * @brief γ,  clusters grid points towards both ends:  xᵢ = L/2 (1 + tanh(γ(2i/(N - 1) - 1)) / tanh γ)  (0 for a
+   * uniform grid).
+   */
+  real_type grid_grading;
+
   /**
    * @brief f(x)
    */
   temperature_function_type * initial_condition;
 
+  /**
+   * @brief Count of refinement levels on top of the base grid  (0 disables refinement).
+   */
+  size_t refinement_levels;
+
+  /**
+   * @brief |uᵢ₊₁ - uᵢ|  above which a cell gets refined.
+   */
+  real_type refinement_threshold;
+
+  /**
+   * @brief q(x),  optional.
+   */
+  coefficient_function_type * source_profile;
+
+  /**
+   * @brief g(t),  optional  (1 when  `NULL').
+   */
+  coefficient_function_type * source_modulation;
+
   /**
    * @brief L
    */
@@ -245,12 +291,17 @@ parameters_Construct (
   real_type diffusivity, temperature_function_type * initial_condition,
   real_type boundary_condition_0, real_type boundary_condition_1,
   real_type time_max, real_type space_max,
-  size_t time_points, size_t space_points
+  size_t time_points, size_t space_points,
+  real_type compression_tolerance,
+  real_type grid_grading, size_t refinement_levels, real_type refinement_threshold
 )
 {
   assert (initial_condition != NULL);
   assert (time_points > 1);
   assert (space_points > 1);
+  assert (compression_tolerance >= 0.0);
+  assert (grid_grading >= 0.0);
+  assert (refinement_threshold >= 0.0);
 
   struct Parameters * const new_parameters = parameters_Allocate ();
   if (new_parameters == NULL)
@@ -260,8 +311,15 @@ parameters_Construct (
 
   new_parameters->boundary_condition_0 = boundary_condition_0;
   new_parameters->boundary_condition_1 = boundary_condition_1;
+  new_parameters->compression_tolerance = compression_tolerance;
   new_parameters->diffusivity = diffusivity;
+  new_parameters->diffusivity_profile = NULL;
+  new_parameters->grid_grading = grid_grading;
   new_parameters->initial_condition = initial_condition;
+  new_parameters->refinement_levels = refinement_levels;
+  new_parameters->refinement_threshold = refinement_threshold;
+  new_parameters->source_profile = NULL;
+  new_parameters->source_modulation = NULL;
   new_parameters->space_max = space_max;
   new_parameters->space_points = space_points;
   new_parameters->time_max = time_max;
@@ -286,16 +344,17 @@ parameters_Write_File (const struct Parameters * parameters, FILE * output)
 
   return fprintf (
     output,
-    "Parameters{boundary_condition_0=%.*f;boundary_condition_1=%.*f;diffusivity=%.*f;space_max=%.*f;space_points=%zu;time_max=%.*f;time_points=%zu;}",
+    "Parameters{boundary_condition_0=%.*f;boundary_condition_1=%.*f;compression_tolerance=%.*f;diffusivity=%.*f;grid_grading=%.*f;refinement_levels=%zu;refinement_threshold=%.*f;space_max=%.*f;space_points=%zu;time_max=%.*f;time_points=%zu;}",
     DECIMAL_DIG, parameters->boundary_condition_0, DECIMAL_DIG, parameters->boundary_condition_1,
-    DECIMAL_DIG, parameters->diffusivity, DECIMAL_DIG, parameters->space_max, parameters->space_points,
+    DECIMAL_DIG, parameters->compression_tolerance, DECIMAL_DIG, parameters->diffusivity,
+    DECIMAL_DIG, parameters->grid_grading, parameters->refinement_levels, DECIMAL_DIG, parameters->refinement_threshold, DECIMAL_DIG, parameters->space_max, parameters->space_points,
     DECIMAL_DIG, parameters->time_max, parameters->time_points
   );
 }
 
 
-#define PARAMETERS_STRING_BUFFER_LENGTH (384)
-#define PARAMETERS_MEMBERS_COUNT (7)
+#define PARAMETERS_STRING_BUFFER_LENGTH (512)
+#define PARAMETERS_MEMBERS_COUNT (11)
 
 
 struct Parameters *
@@ -328,8 +387,10 @@ parameters_Read_File (FILE * input)
 
   const int assigned_parameters = sscanf (
     buffer,
-    "Parameters{boundary_condition_0=%lf;boundary_condition_1=%lf;diffusivity=%lf;space_max=%lf;space_points=%zu;time_max=%lf;time_points=%zu;};",
-    & new_parameters->boundary_condition_0, & new_parameters->boundary_condition_1, & new_parameters->diffusivity,
+    "Parameters{boundary_condition_0=%lf;boundary_condition_1=%lf;compression_tolerance=%lf;diffusivity=%lf;grid_grading=%lf;refinement_levels=%zu;refinement_threshold=%lf;space_max=%lf;space_points=%zu;time_max=%lf;time_points=%zu;};",
+    & new_parameters->boundary_condition_0, & new_parameters->boundary_condition_1,
+    & new_parameters->compression_tolerance, & new_parameters->diffusivity,
+    & new_parameters->grid_grading, & new_parameters->refinement_levels, & new_parameters->refinement_threshold,
     & new_parameters->space_max, & new_parameters->space_points, & new_parameters->time_max,
     & new_parameters->time_points
   );
@@ -342,336 +403,3015 @@ parameters_Read_File (FILE * input)
     return NULL;
   }
 
+  new_parameters->diffusivity_profile = NULL;
+  new_parameters->initial_condition = NULL;
+  new_parameters->source_profile = NULL;
+  new_parameters->source_modulation = NULL;
+
   return new_parameters;
 }
 
 
-inline real_type
+static inline real_type
 lerp (real_type x, real_type x_0, real_type x_1, real_type y_0, real_type y_1)
 {
   return y_0 + (x - x_0) * (y_1 - y_0) / (x_1 - x_0);
 }
 
 
-typedef int solution_visitor_type (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point);
+/**
+ * @brief xᵢ  of the base grid,  see  `grid_grading'.
+ */
+static inline real_type
+parameters_Space (const struct Parameters * parameters, size_t space_point)
+{
+  const real_type uniform = lerp (
+    (real_type) space_point, 0.0, (real_type) (parameters->space_points - 1), 0.0, parameters->space_max
+  );
+  if (! (parameters->grid_grading > 0.0))
+  {
+    return uniform;
+  }
 
+  const real_type grading = parameters->grid_grading;
+  const real_type centred = 2.0 * uniform / parameters->space_max - 1.0;
+
+  return 0.5 * parameters->space_max * (1.0 + tanh (grading * centred) / tanh (grading));
+}
 
-#define METHOD_EULER (1)
-#define METHOD_RK4 (METHOD_EULER + 1)
 
+#define REAL_ARRAY_ALIGNMENT (64)
 
-inline real_type
-f (real_type space_step, real_type time_step, real_type diffusivity, real_type u_0, real_type u_1, real_type u_2)
+
+real_type *
+realArray_Allocate (size_t count)
 {
-  return time_step
-    * diffusivity
-    * (
-                u_0
-        - 2.0 * u_1
-        +       u_2
-      )
-    / pow (space_step, 2.0);
+  const size_t bytes = count * sizeof (real_type);
+#ifdef _WIN32
+  real_type * const new_array = _aligned_malloc (bytes, REAL_ARRAY_ALIGNMENT);
+#else  // _WIN32
+  void * new_array = NULL;
+  if (posix_memalign (& new_array, REAL_ARRAY_ALIGNMENT, bytes) != 0)
+  {
+    new_array = NULL;
+  }
+#endif  // _WIN32
+  if (new_array == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for array (%zu bytes).\n", bytes);
+
+    return NULL;
+  }
+
+  return new_array;
 }
 
 
-int
-solve (
-  const struct Parameters * parameters, solution_visitor_type * before_solution, solution_visitor_type * on_solution
+void
+realArray_Destroy (real_type * array)
+{
+#ifdef _WIN32
+  _aligned_free (array);
+#else  // _WIN32
+  free (array);
+#endif  // _WIN32
+}
+
+
+/**
+ * @brief Precomputed coefficients of the conservative scheme on points  x₀ < … < xₙ₋₁
+ * uᵢ' = uᵢ + wᵢ (Fᵢ₊½ (uᵢ₊₁ - uᵢ) - Fᵢ₋½ (uᵢ - uᵢ₋₁)) + sᵢ g(t).
+ */
+struct Coefficients
+{
+  /**
+   * @brief Fᵢ₊½ = α(xᵢ₊½) Δt / (xᵢ₊₁ - xᵢ),  i ∈ [0, N - 1).
+   */
+  real_type * faces;
+
+  /**
+   * @brief wᵢ = 2 / (xᵢ₊₁ - xᵢ₋₁),  i ∈ (0, N - 1).
+   */
+  real_type * inverse_widths;
+
+  /**
+   * @brief sᵢ = q(xᵢ) Δt,  i ∈ [0, N).
+   */
+  real_type * sources;
+
+  real_type diffusivity_min;
+
+  real_type diffusivity_max;
+
+  /**
+   * @brief max wᵢ (Fᵢ₋½ + Fᵢ₊½);  the spectrum of the scheme lies in  [-2 stability, 0].
+   */
+  real_type stability;
+
+  size_t space_points;
+};
+
+
+void
+coefficients_Destroy (struct Coefficients * coefficients)
+{
+  if (coefficients != NULL)
+  {
+    realArray_Destroy (coefficients->faces);
+    realArray_Destroy (coefficients->inverse_widths);
+    realArray_Destroy (coefficients->sources);
+  }
+
+  free (coefficients);
+}
+
+
+struct Coefficients *
+coefficients_Construct (
+  const struct Parameters * parameters, const real_type * positions, size_t space_points, real_type time_step
 )
 {
   assert (parameters != NULL);
+  assert (positions != NULL);
+  assert (space_points > 1);
 
-  if (before_solution != NULL)
+  const size_t bytes = sizeof (struct Coefficients);
+  struct Coefficients * const new_coefficients = calloc (1, bytes);
+  if (new_coefficients == NULL)
   {
-    const int visited = before_solution (parameters, NULL, - 1);
-    if (visited != 0)
-    {
-      fprintf (stderr, "Error: something went wrong.\n");
+    fprintf (stderr, "Error: couldn't allocate memory for coefficients (%zu bytes).\n", bytes);
 
-      return visited;
-    }
+    return NULL;
   }
 
-  const struct Mesh * const mesh = mesh_Construct (2, parameters->space_points);
-  if (mesh == NULL)
+  new_coefficients->space_points = space_points;
+  new_coefficients->faces = realArray_Allocate (space_points - 1);
+  new_coefficients->inverse_widths = realArray_Allocate (space_points);
+  new_coefficients->sources = realArray_Allocate (space_points);
+  if (
+       new_coefficients->faces == NULL || new_coefficients->inverse_widths == NULL
+    || new_coefficients->sources == NULL
+  )
   {
-    fprintf (stderr, "Error: couldn't allocate memory for mesh.\n");
+    fprintf (stderr, "Error: couldn't allocate memory for coefficient arrays.\n");
 
-    return - 1;
+    coefficients_Destroy (new_coefficients);
+
+    return NULL;
   }
 
-  mesh_Set (mesh, 0, 0, parameters->boundary_condition_0);
-  mesh_Set (mesh, 0, mesh->space_points - 1, parameters->boundary_condition_1);
-  for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
+  new_coefficients->diffusivity_min = INFINITY;
+  new_coefficients->diffusivity_max = - INFINITY;
+  for (size_t face = 0; face < space_points - 1; ++ face)
   {
-    const real_type space = lerp (
-      (real_type) space_point, 0.0, (real_type) (mesh->space_points - 1), 0.0, parameters->space_max
-    );
-    const real_type temperature = parameters->initial_condition (space);
-    mesh_Set (mesh, 0, space_point, temperature);
+    const real_type width = positions [face + 1] - positions [face];
+    assert (width > 0.0);
+    const real_type diffusivity =
+      parameters->diffusivity_profile != NULL
+        ? parameters->diffusivity_profile (0.5 * (positions [face] + positions [face + 1]))
+        : parameters->diffusivity;
+    assert (diffusivity >= 0.0);
+    new_coefficients->faces [face] = diffusivity * time_step / width;
+    new_coefficients->diffusivity_min = fmin (new_coefficients->diffusivity_min, diffusivity);
+    new_coefficients->diffusivity_max = fmax (new_coefficients->diffusivity_max, diffusivity);
   }
 
-  if (on_solution != NULL)
+  new_coefficients->stability = 0.0;
+  new_coefficients->inverse_widths [0] = 0.0;
+  new_coefficients->inverse_widths [space_points - 1] = 0.0;
+  for (size_t space_point = 1; space_point < space_points - 1; ++ space_point)
   {
-    const int visited = on_solution (parameters, mesh, 0);
-    if (visited != 0)
-    {
-      fprintf (stderr, "Error: something went wrong.\n");
-
-      mesh_Destroy (mesh);
-
-      return visited;
-    }
+    const real_type inverse_width = 2.0 / (positions [space_point + 1] - positions [space_point - 1]);
+    new_coefficients->inverse_widths [space_point] = inverse_width;
+    new_coefficients->stability = fmax (
+      new_coefficients->stability,
+      inverse_width * (new_coefficients->faces [space_point - 1] + new_coefficients->faces [space_point])
+    );
   }
 
-  const real_type time_step = parameters->time_max / (real_type) parameters->time_points;
-  const real_type space_step = parameters->space_max / (real_type) parameters->space_points;
-#if METHOD == METHOD_EULER
-  const real_type r = parameters->diffusivity * (time_step / pow (space_step, 2.0));
-  assert (r <= 0.5);
-#endif  // METHOD == METHOD_EULER
-  for (size_t time_point = 1; time_point < parameters->time_points; ++ time_point)
+  for (size_t space_point = 0; space_point < space_points; ++ space_point)
   {
-    mesh_Set (mesh, time_point, 0, parameters->boundary_condition_0);
-    mesh_Set (mesh, time_point, mesh->space_points - 1, parameters->boundary_condition_1);
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif  // WITH_OMP
-    for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
-    {
-#if METHOD == METHOD_EULER
-      /*
-       * Forward-time central-space scheme.
-       * Time:  1st order forward difference  (explicit Euler method aka explicit 1-st order Runge-Kutta method).
-       * Space:  2nd order central difference.
-       */
-/*      const real_type temperature =
-          mesh_Get (mesh, time_point - 1, space_point)
-        + time_step
-        * parameters->diffusivity
-        * (
-                    mesh_Get (mesh, time_point - 1, space_point - 1)
-            - 2.0 * mesh_Get (mesh, time_point - 1, space_point    )
-            +       mesh_Get (mesh, time_point - 1, space_point + 1)
-          )
-        / pow (space_step, 2.0);*/
-      const real_type temperature =
-          (1.0 - 2.0 * r) * mesh_Get (mesh, time_point - 1, space_point    )
-        +              r  * mesh_Get (mesh, time_point - 1, space_point - 1)
-        +              r  * mesh_Get (mesh, time_point - 1, space_point + 1);
-      mesh_Set (mesh, time_point, space_point, temperature);
-#elif METHOD == METHOD_RK4
-      /**
-       * Time:  explicit 4-th order Runge-Kutta method.
-       * Space:  2nd order central difference.
-       */
-/*      const real_type k_1 =
-          time_step
-        * parameters->diffusivity
-        * (
-                    mesh_Get (mesh, time_point - 1, space_point - 1)
-            - 2.0 * mesh_Get (mesh, time_point - 1, space_point    )
-            +       mesh_Get (mesh, time_point - 1, space_point + 1)
-          )
-        / pow (space_step, 2.0);
-      const real_type k_2 =
-          time_step
-        * parameters->diffusivity
-        * (
-                    (mesh_Get (mesh, time_point - 1, space_point - 1) + k_1 / 2.0)
-            - 2.0 * (mesh_Get (mesh, time_point - 1, space_point    ) + k_1 / 2.0)
-            +       (mesh_Get (mesh, time_point - 1, space_point + 1) + k_1 / 2.0)
-          )
-        / pow (space_step, 2.0);
-      const real_type k_3 =
-          time_step
-        * parameters->diffusivity
-        * (
-                    (mesh_Get (mesh, time_point - 1, space_point - 1) + k_2 / 2.0)
-            - 2.0 * (mesh_Get (mesh, time_point - 1, space_point    ) + k_2 / 2.0)
-            +       (mesh_Get (mesh, time_point - 1, space_point + 1) + k_2 / 2.0)
-          )
-        / pow (space_step, 2.0);
-      const real_type k_4 =
-          time_step
-        * parameters->diffusivity
-        * (
-                    (mesh_Get (mesh, time_point - 1, space_point - 1) + k_3)
-            - 2.0 * (mesh_Get (mesh, time_point - 1, space_point    ) + k_3)
-            +       (mesh_Get (mesh, time_point - 1, space_point + 1) + k_3)
-          )
-        / pow (space_step, 2.0);*/
-      const real_type k_1 = f (
-        space_step, time_step, parameters->diffusivity,
-        mesh_Get (mesh, time_point - 1, space_point - 1),
-        mesh_Get (mesh, time_point - 1, space_point    ),
-        mesh_Get (mesh, time_point - 1, space_point + 1)
-      );
-      const real_type k_2 = f (
-        space_step, time_step, parameters->diffusivity,
-        mesh_Get (mesh, time_point - 1, space_point - 1) + k_1 / 2.0,
-        mesh_Get (mesh, time_point - 1, space_point    ) + k_1 / 2.0,
-        mesh_Get (mesh, time_point - 1, space_point + 1) + k_1 / 2.0
-      );
-      const real_type k_3 = f (
-        space_step, time_step, parameters->diffusivity,
-        mesh_Get (mesh, time_point - 1, space_point - 1) + k_2 / 2.0,
-        mesh_Get (mesh, time_point - 1, space_point    ) + k_2 / 2.0,
-        mesh_Get (mesh, time_point - 1, space_point + 1) + k_2 / 2.0
-      );
-      const real_type k_4 = f (
-        space_step, time_step, parameters->diffusivity,
-        mesh_Get (mesh, time_point - 1, space_point - 1) + k_3,
-        mesh_Get (mesh, time_point - 1, space_point    ) + k_3,
-        mesh_Get (mesh, time_point - 1, space_point + 1) + k_3
-      );
-      const real_type temperature =
-          mesh_Get (mesh, time_point - 1, space_point)
-        + (
-                    k_1
-            + 2.0 * k_2
-            + 2.0 * k_3
-            +       k_4
-          )
-        / 6.0;
-      mesh_Set (mesh, time_point, space_point, temperature);
-#else  // METHOD == METHOD_RK4
-#error "Unsupported method."
-#endif  // METHOD == METHOD_EULER
-    }
-
-    if (on_solution != NULL)
-    {
-      const int visited = on_solution (parameters, mesh, time_point);
-      if (visited != 0)
-      {
-        fprintf (stderr, "Error: something went wrong.\n");
-
-        mesh_Destroy (mesh);
-
-        return visited;
-      }
-    }
+    new_coefficients->sources [space_point] =
+      parameters->source_profile != NULL ? parameters->source_profile (positions [space_point]) * time_step : 0.0;
   }
 
-  return 0;
+  return new_coefficients;
 }
 
 
+/**
+ * @brief Whether the scalar-r kernel computes the same thing:  uniform grid,  constant α,  no source.
+ */
 int
-writeSolution_Stdout (const struct Parameters * parameters_, const struct Mesh * mesh, size_t time_point)
+coefficients_IsUniform (const struct Coefficients * coefficients, const struct Parameters * parameters)
 {
-  fprintf (stdout, "time_point=%zu;\n", time_point);
-  mesh_Write_File (mesh, stdout, "%f");
-//  mesh_Write_File_Formatted (mesh, stdout, "\t% f");
-//  mesh_Write_File_Formatted_AtTimePoint (mesh, stdout, "\t% f", time_point);
-  fprintf (stdout, ";\n");
+  assert (coefficients != NULL);
+  assert (parameters != NULL);
 
-  return 0;
+  return parameters->source_profile == NULL
+    && ! (parameters->grid_grading > 0.0)
+    && ! (coefficients->diffusivity_min < coefficients->diffusivity_max);
 }
 
 
-#define PLOT_EVERY_NTH_SOLUTION (10)
-#define GNUPLOT_SCRIPT_NAME ("plot.gp")
-#define GNUPLOT_SCRIPT_TEMPLATE ( \
-  "set terminal wxt persist\n" \
-  "set xlabel 'Space (x)'\n" \
-  "set ylabel 'Temperature (u(x))'\n" \
-  "#set offsets graph 0.01, 0.01, 0.01, 0.01\n" \
-  "set grid xtics ytics\n" \
-  "set style fill transparent solid 0.333\n" \
-  "filename(x) = sprintf(\"%%d.dat\", x)\n" \
-  "set key autotitle columnhead\n" \
-  "plot for [i = 0:%zu:%zu] filename(i) using 1:2 with lines\n" \
-)
+typedef int solution_visitor_type (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point);
 
 
-int
-writeGnuplotScript_File (const struct Parameters * parameters, const struct Mesh * mesh_, size_t time_point_)
-{
-  FILE * const output = fopen (GNUPLOT_SCRIPT_NAME, "w");
-  if (output == NULL)
-  {
-    fprintf (stderr, "Error: couldn't open output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+#define ANALYTIC_MODES_MAX (256)
+#define ANALYTIC_QUADRATURE_INTERVALS (8192)
+#define ANALYTIC_AMPLITUDE_MIN (1.0e-18)
+#define ANALYTICS_ERROR_EVERY_NTH_SOLUTION (10)
 
-    return - 1;
-  }
 
-  fprintf (output, GNUPLOT_SCRIPT_TEMPLATE, parameters->time_points - 1, PLOT_EVERY_NTH_SOLUTION);
+/**
+ * @brief u(x, t) = β₀ + (β₁ - β₀) x / L + Σ bₙ exp(-α (nπ/L)² t) sin(nπx/L),
+ * bₙ = 2/L ∫ (f(x) - β₀ - (β₁ - β₀) x / L) sin(nπx/L) dx.
+ * The series is truncated to  `ANALYTIC_MODES_MAX'  modes;  bₙ are integrated once by Simpson's rule.
+ */
+struct AnalyticSolution
+{
+  /**
+   * @brief bₙ
+   */
+  real_type * coefficients;
 
-  const int flushed = fflush (output);
-  if (flushed != 0)
-  {
-    fprintf (stderr, "Error: couldn't flush output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+  /**
+   * @brief bₙ exp(-α (nπ/L)² t)  at the current time.
+   */
+  real_type * amplitudes;
 
-    return flushed;
-  }
+  size_t modes;
 
-  const int closed = fclose (output);
-  if (closed != 0)
-  {
-    fprintf (stderr, "Error: couldn't close output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+  size_t active_modes;
 
-    return closed;
-  }
+  real_type boundary_condition_0;
 
-  return 0;
-}
+  real_type boundary_condition_1;
 
+  real_type diffusivity;
 
-#define SOLUTION_FILENAME_BUFFER_LENGTH (48)
-#define WRITE_EVERY_NTH_SOLUTION (10)
+  real_type space_max;
+};
 
 
-int
-writeSolution_File (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point)
+void
+analyticSolution_Destroy (struct AnalyticSolution * analytic_solution)
 {
-  if (time_point % WRITE_EVERY_NTH_SOLUTION != 0)
+  if (analytic_solution != NULL)
   {
-    return 0;
+    free (analytic_solution->coefficients);
+    free (analytic_solution->amplitudes);
   }
 
-  static char filename [SOLUTION_FILENAME_BUFFER_LENGTH];
-  sprintf (filename, "%zu.dat", time_point);
-  FILE * const output = fopen (filename, "w");
-  if (output == NULL)
-  {
-    fprintf (stderr, "Error: couldn't open output file (%s).\n", filename);
+  free (analytic_solution);
+}
 
-    return - 1;
-  }
 
-  const real_type time = lerp (
-    (real_type) time_point, 0.0, (real_type) (parameters->time_points - 1), 0.0, parameters->time_max
-  );
-  fprintf (output, "x \"u(x, %g)\"\n", time);
-  fprintf (output, "# ");
-  parameters_Write_File (parameters, output);
-  fprintf (output, ";\n");
-  fprintf (output, "# time=%f;time_point=%zu;\n", time, time_point);
-  fprintf (output, "# space;temperature;\n");
+struct AnalyticSolution *
+analyticSolution_Construct (const struct Parameters * parameters)
+{
+  assert (parameters != NULL);
+  assert (parameters->initial_condition != NULL);
 
-  for (size_t space_point = 0; space_point < parameters->space_points; ++ space_point)
+  const size_t bytes = sizeof (struct AnalyticSolution);
+  struct AnalyticSolution * const new_analytic_solution = calloc (1, bytes);
+  if (new_analytic_solution == NULL)
   {
-    const real_type space = lerp (
-      (real_type) space_point, 0.0, (real_type) (mesh->space_points - 1), 0.0, parameters->space_max
-    );
-    const real_type temperature = mesh_Get (mesh, time_point, space_point);
-    fprintf (output, "%.*f %.*f\n", DECIMAL_DIG, space, DECIMAL_DIG, temperature);
+    fprintf (stderr, "Error: couldn't allocate memory for analytic solution (%zu bytes).\n", bytes);
+
+    return NULL;
   }
 
-  const int flushed = fflush (output);
-  if (flushed != 0)
+  new_analytic_solution->modes = ANALYTIC_MODES_MAX;
+  new_analytic_solution->coefficients = calloc (ANALYTIC_MODES_MAX, sizeof (real_type));
+  new_analytic_solution->amplitudes = calloc (ANALYTIC_MODES_MAX, sizeof (real_type));
+  if (new_analytic_solution->coefficients == NULL || new_analytic_solution->amplitudes == NULL)
   {
-    fprintf (stderr, "Error: couldn't flush output file (%s).\n", filename);
+    fprintf (stderr, "Error: couldn't allocate memory for analytic solution coefficients.\n");
 
-    return flushed;
+    analyticSolution_Destroy (new_analytic_solution);
+
+    return NULL;
   }
 
-  const int closed = fclose (output);
-  if (closed != 0)
-  {
-    fprintf (stderr, "Error: couldn't close output file (%s).\n", filename);
+  new_analytic_solution->boundary_condition_0 = parameters->boundary_condition_0;
+  new_analytic_solution->boundary_condition_1 = parameters->boundary_condition_1;
+  new_analytic_solution->diffusivity = parameters->diffusivity;
+  new_analytic_solution->space_max = parameters->space_max;
+
+  const real_type interval = parameters->space_max / ANALYTIC_QUADRATURE_INTERVALS;
+  for (size_t node = 1; node < ANALYTIC_QUADRATURE_INTERVALS; ++ node)
+  {
+    const real_type space = (real_type) node * interval;
+    const real_type deviation =
+        parameters->initial_condition (space)
+      - lerp (space, 0.0, parameters->space_max, parameters->boundary_condition_0, parameters->boundary_condition_1);
+    const real_type weight = (node % 2 == 0 ? 2.0 : 4.0) * interval / 3.0;
+    for (size_t mode = 0; mode < ANALYTIC_MODES_MAX; ++ mode)
+    {
+      new_analytic_solution->coefficients [mode] +=
+        weight * deviation * sin ((real_type) (mode + 1) * PI * space / parameters->space_max);
+    }
+  }
+  for (size_t mode = 0; mode < ANALYTIC_MODES_MAX; ++ mode)
+  {
+    new_analytic_solution->coefficients [mode] *= 2.0 / parameters->space_max;
+  }
+
+  return new_analytic_solution;
+}
+
+
+/**
+ * @brief Decays the modes to  `time'  and drops the negligible tail so that evaluation cost shrinks as  t  grows.
+ */
+void
+analyticSolution_Advance (struct AnalyticSolution * analytic_solution, real_type time)
+{
+  assert (analytic_solution != NULL);
+
+  analytic_solution->active_modes = 0;
+  for (size_t mode = 0; mode < analytic_solution->modes; ++ mode)
+  {
+    const real_type wavenumber = (real_type) (mode + 1) * PI / analytic_solution->space_max;
+    const real_type amplitude =
+      analytic_solution->coefficients [mode] * exp (- analytic_solution->diffusivity * wavenumber * wavenumber * time);
+    analytic_solution->amplitudes [mode] = amplitude;
+    if (fabs (amplitude) > ANALYTIC_AMPLITUDE_MIN)
+    {
+      analytic_solution->active_modes = mode + 1;
+    }
+  }
+}
+
+
+/**
+ * @brief Sums the series with the  sin((n + 1)θ) = 2 cos θ sin(nθ) - sin((n - 1)θ)  recurrence  (no tables, no
+ * memory traffic beyond the amplitudes).
+ */
+static inline real_type
+analyticSolution_Evaluate (const struct AnalyticSolution * analytic_solution, real_type space)
+{
+  const real_type angle = PI * space / analytic_solution->space_max;
+  const real_type twice_cosine = 2.0 * cos (angle);
+  real_type sine_previous = 0.0;
+  real_type sine = sin (angle);
+  real_type sum = lerp (
+    space, 0.0, analytic_solution->space_max, analytic_solution->boundary_condition_0,
+    analytic_solution->boundary_condition_1
+  );
+  for (size_t mode = 0; mode < analytic_solution->active_modes; ++ mode)
+  {
+    sum += analytic_solution->amplitudes [mode] * sine;
+    const real_type sine_next = twice_cosine * sine - sine_previous;
+    sine_previous = sine;
+    sine = sine_next;
+  }
+
+  return sum;
+}
+
+
+/**
+ * @brief Per-step in-situ reductions,  see  `solve'.
+ */
+struct Analytics
+{
+  real_type time;
+
+  /**
+   * @brief Bounds of the base row.  With refinement they may be too wide:  they are reduced while the base row is
+   * updated,  before the first level is injected into it,  so a value the injection overwrites still counts.
+   */
+  real_type temperature_min;
+
+  real_type temperature_max;
+
+  /**
+   * @brief ∫u dx  (trapezoidal rule).  With refinement it isn't conserved across patch ends,  see
+   * `struct Refinement'.
+   */
+  real_type energy;
+
+  /**
+   * @brief -α∂u/∂x  at  x = 0  (2nd order one-sided difference).
+   */
+  real_type heat_flux_0;
+
+  /**
+   * @brief -α∂u/∂x  at  x = L  (2nd order one-sided difference).
+   */
+  real_type heat_flux_1;
+
+  /**
+   * @brief (∫(u - uₑₓₐ꜀ₜ)² dx)^½,  evaluated every  `ANALYTICS_ERROR_EVERY_NTH_SOLUTION'-th time point  (NaN
+   * otherwise)  since the series costs  O(modes)  per point.  Always NaN with α(x) or q(x):  the series assumes
+   * constant α and no source;  and never evaluated without  `on_analytics'.
+   */
+  real_type error_l2;
+};
+
+
+typedef int analytics_visitor_type (
+  const struct Parameters * parameters, const struct Analytics * analytics, size_t time_point
+);
+
+
+#define METHOD_EULER (1)
+#define METHOD_RK4 (METHOD_EULER + 1)
+
+
+/*
+ * Explicit Runge-Kutta methods by their nodes  cₛ  and weights  bₛ;  all stages but the first take the previous
+ * stage only  (aₛ,ₛ₋₁ = cₛ),  which covers both methods.  The stability limit is the largest  |λΔt|  on the negative
+ * real axis.
+ */
+#if METHOD == METHOD_EULER
+#define METHOD_STAGES (1)
+#define METHOD_STABILITY_LIMIT (2.0)
+static const real_type method_nodes [METHOD_STAGES] = { 0.0 };
+static const real_type method_weights [METHOD_STAGES] = { 1.0 };
+#elif METHOD == METHOD_RK4
+#define METHOD_STAGES (4)
+#define METHOD_STABILITY_LIMIT (2.785)
+static const real_type method_nodes [METHOD_STAGES] = { 0.0, 0.5, 0.5, 1.0 };
+static const real_type method_weights [METHOD_STAGES] = { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 };
+#else  // METHOD == METHOD_RK4
+#error "Unsupported method."
+#endif  // METHOD == METHOD_EULER
+
+
+/**
+ * @brief Folds one interior point into the running reductions;  called from inside the update loops,  which it must
+ * not keep from vectorizing.
+ */
+static inline void
+analytics_Accumulate (
+  real_type * restrict temperature_min, real_type * restrict temperature_max, real_type * restrict energy,
+  real_type weight, real_type temperature
+)
+{
+  * temperature_min = temperature < * temperature_min ? temperature : * temperature_min;
+  * temperature_max = temperature > * temperature_max ? temperature : * temperature_max;
+  * energy += weight * temperature;
+}
+
+
+#ifdef WITH_ANALYTICS
+/**
+ * @brief (∫(u - uₑₓₐ꜀ₜ)² dx)^½  over a row,  trapezoidal;  a pass of its own since the series costs  O(modes)  per
+ * point and,  folded into the update loop,  kept that loop from vectorizing on the other time points too.
+ */
+static real_type
+analytics_Error (
+  const struct AnalyticSolution * analytic_solution, const struct Mesh * mesh, size_t time_point,
+  const real_type * positions
+)
+{
+  const real_type * const row = & mesh->points [mesh_PointIndex (mesh, time_point, 0)];
+  real_type error_squared = 0.0;
+#ifdef WITH_OMP
+#pragma omp parallel for reduction(+:error_squared)
+#endif  // WITH_OMP
+  for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
+  {
+    const real_type error = row [space_point] - analyticSolution_Evaluate (analytic_solution, positions [space_point]);
+    error_squared += 0.5 * (positions [space_point + 1] - positions [space_point - 1]) * error * error;
+  }
+
+  return sqrt (error_squared);
+}
+#endif  // WITH_ANALYTICS
+
+
+/**
+ * @brief  du/dx  at  x₀  from  u₀, u₁, u₂  at  x₀, x₀ + h₁, x₀ + h₁ + h₂  (2nd order one-sided).
+ */
+static inline real_type
+derivative_OneSided (real_type h_1, real_type h_2, real_type u_0, real_type u_1, real_type u_2)
+{
+  return
+    - (2.0 * h_1 + h_2) / (h_1 * (h_1 + h_2)) * u_0
+    + (h_1 + h_2) / (h_1 * h_2) * u_1
+    - h_1 / (h_2 * (h_1 + h_2)) * u_2;
+}
+
+
+/**
+ * @brief Turns the interior sums gathered by  `analytics_Accumulate'  into the final values by adding the boundary
+ * terms of the freshly written row.  A grid of two points has no third one for the one-sided stencil,  so the fluxes
+ * fall back to the 1st order difference there.
+ */
+static inline void
+analytics_Complete (
+  struct Analytics * analytics, const struct Mesh * mesh, size_t time_point, real_type time,
+  const real_type * positions, real_type diffusivity_0, real_type diffusivity_1
+)
+{
+  const size_t last = mesh->space_points - 1;
+  const real_type u_0 = mesh_Get (mesh, time_point, 0);
+  const real_type u_1 = mesh_Get (mesh, time_point, 1);
+  const real_type u_n_1 = mesh_Get (mesh, time_point, last - 1);
+  const real_type u_n = mesh_Get (mesh, time_point, last);
+  const real_type h_0_1 = positions [1] - positions [0];
+  const real_type h_n_1 = positions [last] - positions [last - 1];
+
+  analytics->time = time;
+  analytics->temperature_min = fmin (analytics->temperature_min, fmin (u_0, u_n));
+  analytics->temperature_max = fmax (analytics->temperature_max, fmax (u_0, u_n));
+  analytics->energy += 0.5 * (h_0_1 * u_0 + h_n_1 * u_n);
+  if (last < 2)
+  {
+    analytics->heat_flux_0 = - diffusivity_0 * (u_1 - u_0) / h_0_1;
+    analytics->heat_flux_1 = - diffusivity_1 * (u_n - u_n_1) / h_n_1;
+
+    return;
+  }
+
+  const real_type u_2 = mesh_Get (mesh, time_point, 2);
+  const real_type u_n_2 = mesh_Get (mesh, time_point, last - 2);
+  const real_type h_0_2 = positions [2] - positions [1];
+  const real_type h_n_2 = positions [last - 1] - positions [last - 2];
+  analytics->heat_flux_0 = - diffusivity_0 * derivative_OneSided (h_0_1, h_0_2, u_0, u_1, u_2);
+  analytics->heat_flux_1 = diffusivity_1 * derivative_OneSided (h_n_1, h_n_2, u_n, u_n_1, u_n_2);
+}
+
+
+/**
+ * @brief Δt (∂/∂x(α∂u/∂x) + q)  in conservative flux form;  F₀, F₁  are the left & right face coefficients,  w  the
+ * inverse cell width.
+ */
+static inline real_type
+f_Flux (
+  real_type face_0, real_type face_1, real_type inverse_width, real_type source,
+  real_type u_0, real_type u_1, real_type u_2
+)
+{
+  return inverse_width * (face_1 * (u_2 - u_1) - face_0 * (u_1 - u_0)) + source;
+}
+
+
+/**
+ * @brief Branch-free increment  Δt F(u)ᵢ  of one point from a row and the precomputed coefficients.
+ */
+static inline real_type
+stencil_Flux (
+  const real_type * restrict u, const struct Coefficients * restrict coefficients, real_type modulation,
+  size_t space_point
+)
+{
+  return f_Flux (
+    coefficients->faces [space_point - 1], coefficients->faces [space_point],
+    coefficients->inverse_widths [space_point], modulation * coefficients->sources [space_point],
+    u [space_point - 1], u [space_point], u [space_point + 1]
+  );
+}
+
+
+/**
+ * @brief Increment  Δt α ∂²u/∂x²  of one point on the uniform grid,  r = αΔt/Δx².
+ */
+static inline real_type
+stencil_Scalar (const real_type * restrict u, real_type r, size_t space_point)
+{
+  return r * (u [space_point - 1] - 2.0 * u [space_point] + u [space_point + 1]);
+}
+
+
+/**
+ * @brief Row read by stage  `stage'  for  F:  u  itself for the first stage,  a stage row afterwards.
+ */
+static inline const real_type *
+method_Input (const real_type * row, real_type * const * stage_rows, size_t stage)
+{
+  return stage == 0 ? row : stage_rows [(stage - 1) % 2];
+}
+
+
+/**
+ * @brief Stage  `stage'  (any but the last)  of the step from  u = `row'  over points  [begin, end):
+ * kₛ = Δt F(input);  `partial_row'  gathers  u + Σ bₛkₛ  and  `stage_rows [stage % 2]'  gets  u + cₛ₊₁kₛ,  the
+ * input of the next stage.  Stages are whole-row sweeps since  F  couples neighbours;  the last one is left to the
+ * caller so that it can fuse its own work.  Without coefficients the uniform-grid kernel with  `r'  is used.
+ */
+static void
+method_Stage (
+  size_t stage, const real_type * restrict row, real_type * restrict partial_row, real_type * const * stage_rows,
+  const struct Coefficients * coefficients, real_type r, real_type modulation, size_t begin, size_t end,
+  int parallel
+)
+{
+  assert (stage + 1 < METHOD_STAGES);
+
+  const real_type * restrict const input_row = method_Input (row, stage_rows, stage);
+  real_type * restrict const output_row = stage_rows [stage % 2];
+  const real_type weight = method_weights [stage];
+  const real_type node = method_nodes [stage + 1];
+  if (coefficients != NULL)
+  {
+#ifdef WITH_OMP
+#pragma omp parallel for if (parallel)
+#endif  // WITH_OMP
+    for (size_t space_point = begin; space_point < end; ++ space_point)
+    {
+      const real_type increment = stencil_Flux (input_row, coefficients, modulation, space_point);
+      partial_row [space_point] = (stage == 0 ? row [space_point] : partial_row [space_point]) + weight * increment;
+      output_row [space_point] = row [space_point] + node * increment;
+    }
+  }
+  else
+  {
+#ifdef WITH_OMP
+#pragma omp parallel for if (parallel)
+#endif  // WITH_OMP
+    for (size_t space_point = begin; space_point < end; ++ space_point)
+    {
+      const real_type increment = stencil_Scalar (input_row, r, space_point);
+      partial_row [space_point] = (stage == 0 ? row [space_point] : partial_row [space_point]) + weight * increment;
+      output_row [space_point] = row [space_point] + node * increment;
+    }
+  }
+
+#ifndef WITH_OMP
+  (void) parallel;
+#endif  // WITH_OMP
+}
+
+
+#define REFINEMENT_LEVELS_MAX (8)
+#define REFINEMENT_SUBSTEPS (4)
+#define REFINEMENT_BUFFER_CELLS (2)
+#define REFINEMENT_MERGE_GAP (4)
+#define REFINEMENT_CHUNKS_PER_THREAD (4)
+#define REFINEMENT_CHUNK_POINTS_MIN (256)
+#define REGRID_EVERY_NTH_SOLUTION (10)
+
+
+/**
+ * @brief Block of a refinement level covering the parent points  [begin / 2, begin / 2 + (points - 1) / 2]  with
+ * twice the resolution:  even points coincide with parent points,  odd ones sit at the midpoints.
+ * `begin'  is the index of the first point among all points of the level.
+ */
+struct Patch
+{
+  /**
+   * @brief Two rows,  indexed by the level's  `time_point'.
+   */
+  struct Mesh * mesh;
+
+  real_type * positions;
+
+  struct Coefficients * coefficients;
+
+  /**
+   * @brief Inputs of the inner stages of the method,  one allocation  (`NULL'  with a single stage).
+   */
+  real_type * stage_rows [2];
+
+  size_t begin;
+
+  /**
+   * @brief Index of the enclosing patch on the coarser level  (unused on the first level).
+   */
+  size_t parent;
+};
+
+
+void
+patch_Destroy (struct Patch * patch)
+{
+  if (patch != NULL)
+  {
+    mesh_Destroy (patch->mesh);
+    realArray_Destroy (patch->positions);
+    coefficients_Destroy (patch->coefficients);
+    realArray_Destroy (patch->stage_rows [0]);
+  }
+
+  free (patch);
+}
+
+
+struct Patch *
+patch_Construct (
+  const struct Parameters * parameters, const real_type * parent_positions, size_t parent_points,
+  size_t begin, size_t parent, real_type time_step
+)
+{
+  assert (parameters != NULL);
+  assert (parent_positions != NULL);
+  assert (parent_points > 1);
+
+  const size_t bytes = sizeof (struct Patch);
+  struct Patch * const new_patch = calloc (1, bytes);
+  if (new_patch == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for patch (%zu bytes).\n", bytes);
+
+    return NULL;
+  }
+
+  const size_t points = 2 * (parent_points - 1) + 1;
+  new_patch->begin = begin;
+  new_patch->parent = parent;
+  new_patch->mesh = mesh_Construct (2, points);
+  new_patch->positions = realArray_Allocate (points);
+  if (METHOD_STAGES > 1)
+  {
+    new_patch->stage_rows [0] = realArray_Allocate (2 * points);
+    new_patch->stage_rows [1] = new_patch->stage_rows [0] == NULL ? NULL : new_patch->stage_rows [0] + points;
+  }
+  if (
+       new_patch->mesh == NULL || new_patch->positions == NULL
+    || (METHOD_STAGES > 1 && new_patch->stage_rows [0] == NULL)
+  )
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for patch points.\n");
+
+    patch_Destroy (new_patch);
+
+    return NULL;
+  }
+
+  for (size_t parent_point = 0; parent_point < parent_points; ++ parent_point)
+  {
+    new_patch->positions [2 * parent_point] = parent_positions [parent_point];
+    if (parent_point + 1 < parent_points)
+    {
+      new_patch->positions [2 * parent_point + 1] =
+        0.5 * (parent_positions [parent_point] + parent_positions [parent_point + 1]);
+    }
+  }
+
+  new_patch->coefficients = coefficients_Construct (parameters, new_patch->positions, points, time_step);
+  if (new_patch->coefficients == NULL)
+  {
+    fprintf (stderr, "Error: couldn't construct patch coefficients.\n");
+
+    patch_Destroy (new_patch);
+
+    return NULL;
+  }
+
+  assert (2.0 * new_patch->coefficients->stability <= METHOD_STABILITY_LIMIT);
+
+  return new_patch;
+}
+
+
+/**
+ * @brief Interior points  [begin, end)  of one patch;  the unit of work handed to a thread.
+ */
+struct PatchRange
+{
+  size_t patch;
+
+  size_t begin;
+
+  size_t end;
+};
+
+
+struct Level
+{
+  struct Patch ** patches;
+
+  size_t patches_count;
+
+  struct PatchRange * ranges;
+
+  size_t ranges_count;
+
+  size_t time_point;
+
+  real_type time_step;
+};
+
+
+/**
+ * @brief Block-structured refinement with local time stepping  (Berger-Oliger):  each level halves the spacing of
+ * its parent and takes  `REFINEMENT_SUBSTEPS'  steps per parent step.  That keeps  αΔt/Δx²  on a uniform grid with
+ * constant α only:  a graded grid's smallest cells are split into equal halves and α(x) is sampled at new faces,  so
+ * a level may be less stable than the base grid,  see  `refinement_Stability'.
+ * Patch end points take values interpolated in time from the parent;  on completion the patch is injected back.
+ * There is no refluxing:  the parent's flux through a patch end is not replaced by the sum of the patch's fluxes
+ * over its substeps,  so the flux form  (see  `struct Coefficients')  is no longer conservative there and  ∫u dx
+ * drifts by the mismatch.
+ */
+struct Refinement
+{
+  struct Level levels [REFINEMENT_LEVELS_MAX];
+
+  size_t levels_count;
+
+  const real_type * base_positions;
+
+  size_t base_points;
+
+  real_type threshold;
+
+  size_t regrids;
+
+  size_t patches_max;
+
+  size_t point_updates;
+};
+
+
+void
+refinement_Destroy (struct Refinement * refinement)
+{
+  if (refinement != NULL)
+  {
+    for (size_t level = 0; level < refinement->levels_count; ++ level)
+    {
+      for (size_t patch = 0; patch < refinement->levels [level].patches_count; ++ patch)
+      {
+        patch_Destroy (refinement->levels [level].patches [patch]);
+      }
+      free (refinement->levels [level].patches);
+      free (refinement->levels [level].ranges);
+    }
+  }
+
+  free (refinement);
+}
+
+
+#define REFINEMENT_WINDOW_POINTS ((2 << REFINEMENT_LEVELS_MAX) + 1)
+
+
+/**
+ * @brief max wᵢ (Fᵢ₋½ + Fᵢ₊½)  of every level,  as  `coefficients_Construct'  would compute it for a patch covering
+ * the whole base grid.  The level points are bisected from windows of two base cells the way  `patch_Construct'
+ * does,  so a patch anywhere has the very same coefficients.
+ */
+static void
+refinement_Stability (
+  const struct Parameters * parameters, const struct Refinement * refinement, real_type * stability
+)
+{
+  for (size_t level = 0; level < refinement->levels_count; ++ level)
+  {
+    stability [level] = 0.0;
+  }
+
+  real_type window [REFINEMENT_WINDOW_POINTS];
+  for (size_t base_point = 0; base_point + 1 < refinement->base_points; ++ base_point)
+  {
+    size_t points = base_point + 2 < refinement->base_points ? 3 : 2;
+    memcpy (window, refinement->base_positions + base_point, points * sizeof (real_type));
+    for (size_t level = 0; level < refinement->levels_count; ++ level)
+    {
+      for (size_t point = points - 1; point > 0; -- point)
+      {
+        const real_type midpoint = 0.5 * (window [point - 1] + window [point]);
+        window [2 * point] = window [point];
+        window [2 * point - 1] = midpoint;
+      }
+      points = 2 * (points - 1) + 1;
+
+      const real_type time_step = refinement->levels [level].time_step;
+      real_type face_0 = 0.0;
+      for (size_t point = 0; point + 1 < points; ++ point)
+      {
+        const real_type diffusivity =
+          parameters->diffusivity_profile != NULL
+            ? parameters->diffusivity_profile (0.5 * (window [point] + window [point + 1]))
+            : parameters->diffusivity;
+        const real_type face_1 = diffusivity * time_step / (window [point + 1] - window [point]);
+        if (point > 0)
+        {
+          const real_type inverse_width = 2.0 / (window [point + 1] - window [point - 1]);
+          stability [level] = fmax (stability [level], inverse_width * (face_0 + face_1));
+        }
+        face_0 = face_1;
+      }
+    }
+  }
+}
+
+
+struct Refinement *
+refinement_Construct (const struct Parameters * parameters, const real_type * base_positions, real_type time_step)
+{
+  assert (parameters != NULL);
+  assert (base_positions != NULL);
+
+  if (parameters->refinement_levels > REFINEMENT_LEVELS_MAX)
+  {
+    fprintf (
+      stderr, "Error: too many refinement levels (%zu, at most %d).\n",
+      parameters->refinement_levels, REFINEMENT_LEVELS_MAX
+    );
+
+    return NULL;
+  }
+
+  const size_t bytes = sizeof (struct Refinement);
+  struct Refinement * const new_refinement = calloc (1, bytes);
+  if (new_refinement == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for refinement (%zu bytes).\n", bytes);
+
+    return NULL;
+  }
+
+  new_refinement->levels_count = parameters->refinement_levels;
+  new_refinement->base_positions = base_positions;
+  new_refinement->base_points = parameters->space_points;
+  new_refinement->threshold = parameters->refinement_threshold;
+  real_type level_time_step = time_step;
+  for (size_t level = 0; level < new_refinement->levels_count; ++ level)
+  {
+    level_time_step /= REFINEMENT_SUBSTEPS;
+    new_refinement->levels [level].time_step = level_time_step;
+  }
+
+  real_type stability [REFINEMENT_LEVELS_MAX];
+  refinement_Stability (parameters, new_refinement, stability);
+  for (size_t level = 0; level < new_refinement->levels_count; ++ level)
+  {
+    if (2.0 * stability [level] > METHOD_STABILITY_LIMIT)
+    {
+      fprintf (
+        stderr, "Error: refinement level %zu is unstable (%g > %g), use more time points or fewer levels.\n",
+        level + 1, 2.0 * stability [level], METHOD_STABILITY_LIMIT
+      );
+
+      refinement_Destroy (new_refinement);
+
+      return NULL;
+    }
+  }
+
+  return new_refinement;
+}
+
+
+/**
+ * @brief Parent row of a patch at the parent's time point  `time_point'  and the offset of the patch's first point.
+ */
+static inline real_type *
+refinement_ParentRow (
+  const struct Refinement * refinement, size_t level, const struct Patch * patch,
+  struct Mesh * base, size_t time_point, size_t * offset
+)
+{
+  if (level == 0)
+  {
+    * offset = patch->begin / 2;
+
+    return & base->points [mesh_PointIndex (base, time_point, 0)];
+  }
+
+  const struct Patch * const parent = refinement->levels [level - 1].patches [patch->parent];
+  * offset = patch->begin / 2 - parent->begin;
+
+  return & parent->mesh->points [mesh_PointIndex (parent->mesh, time_point, 0)];
+}
+
+
+/**
+ * @brief Sets both end points of  `row',  a row of  `patch',  to the parent values interpolated linearly at
+ * `fraction'  of the parent step ending at  `parent_time_point'.
+ */
+static void
+refinement_Interpolate_Ends (
+  const struct Refinement * refinement, size_t level, const struct Patch * patch, struct Mesh * base,
+  size_t parent_time_point, real_type fraction, real_type * row
+)
+{
+  const size_t last = patch->mesh->space_points - 1;
+  size_t offset = 0;
+  const real_type * const previous = refinement_ParentRow (
+    refinement, level, patch, base, parent_time_point - 1, & offset
+  );
+  const real_type * const current = refinement_ParentRow (refinement, level, patch, base, parent_time_point, & offset);
+  row [0] = previous [offset] + fraction * (current [offset] - previous [offset]);
+  row [last] = previous [offset + last / 2] + fraction * (current [offset + last / 2] - previous [offset + last / 2]);
+}
+
+
+static int
+refinement_Append (struct Level * level, struct Patch * patch, size_t * capacity)
+{
+  if (level->patches_count == * capacity)
+  {
+    const size_t new_capacity = * capacity == 0 ? 8 : 2 * * capacity;
+    struct Patch ** const new_patches = realloc (level->patches, new_capacity * sizeof (struct Patch *));
+    if (new_patches == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for patches (%zu).\n", new_capacity);
+
+      return - 1;
+    }
+
+    level->patches = new_patches;
+    * capacity = new_capacity;
+  }
+
+  level->patches [level->patches_count ++] = patch;
+
+  return 0;
+}
+
+
+/**
+ * @brief Splits the interior of all patches of a level into ranges of nearly equal size,  so that a static
+ * schedule keeps the threads balanced whatever the patch layout.
+ */
+static int
+refinement_Balance (struct Level * level)
+{
+  size_t interior_points = 0;
+  for (size_t patch = 0; patch < level->patches_count; ++ patch)
+  {
+    interior_points += level->patches [patch]->mesh->space_points - 2;
+  }
+
+#ifdef WITH_OMP
+  const size_t threads = (size_t) omp_get_max_threads ();
+#else  // WITH_OMP
+  const size_t threads = 1;
+#endif  // WITH_OMP
+  const size_t units = threads * REFINEMENT_CHUNKS_PER_THREAD;
+  size_t range_points = (interior_points + units - 1) / units;
+  if (range_points < REFINEMENT_CHUNK_POINTS_MIN)
+  {
+    range_points = REFINEMENT_CHUNK_POINTS_MIN;
+  }
+
+  size_t ranges_count = 0;
+  for (size_t patch = 0; patch < level->patches_count; ++ patch)
+  {
+    ranges_count += (level->patches [patch]->mesh->space_points - 2 + range_points - 1) / range_points;
+  }
+
+  free (level->ranges);
+  level->ranges = NULL;
+  level->ranges_count = 0;
+  if (ranges_count == 0)
+  {
+    return 0;
+  }
+
+  level->ranges = malloc (ranges_count * sizeof (struct PatchRange));
+  if (level->ranges == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for patch ranges (%zu).\n", ranges_count);
+
+    return - 1;
+  }
+
+  for (size_t patch = 0; patch < level->patches_count; ++ patch)
+  {
+    const size_t end = level->patches [patch]->mesh->space_points - 1;
+    for (size_t begin = 1; begin < end; begin += range_points)
+    {
+      struct PatchRange * const range = & level->ranges [level->ranges_count ++];
+      range->patch = patch;
+      range->begin = begin;
+      range->end = begin + range_points < end ? begin + range_points : end;
+    }
+  }
+
+  return 0;
+}
+
+
+/**
+ * @brief Fills the current row of a new patch:  even points from the parent,  odd points from the old patches of
+ * the level where they overlap,  from  f(x)  at  t = 0,  and by linear interpolation otherwise.
+ */
+static void
+refinement_Fill (
+  const struct Parameters * parameters, struct Patch * patch, const real_type * parent_row, size_t time_point,
+  struct Patch * const * old_patches, size_t old_patches_count, size_t old_time_point, int initial
+)
+{
+  const size_t points = patch->mesh->space_points;
+  real_type * const row = & patch->mesh->points [mesh_PointIndex (patch->mesh, time_point, 0)];
+  size_t old_patch = 0;
+  for (size_t point = 0; point < points; ++ point)
+  {
+    if (point % 2 == 0)
+    {
+      row [point] = parent_row [point / 2];
+
+      continue;
+    }
+
+    const size_t global = patch->begin + point;
+    while (
+         old_patch < old_patches_count
+      && old_patches [old_patch]->begin + old_patches [old_patch]->mesh->space_points <= global
+    )
+    {
+      ++ old_patch;
+    }
+
+    if (old_patch < old_patches_count && old_patches [old_patch]->begin <= global)
+    {
+      const struct Patch * const old = old_patches [old_patch];
+      row [point] = mesh_Get (old->mesh, old_time_point, global - old->begin);
+    }
+    else if (initial)
+    {
+      row [point] = parameters->initial_condition (patch->positions [point]);
+    }
+    else
+    {
+      row [point] = 0.5 * (parent_row [point / 2] + parent_row [point / 2 + 1]);
+    }
+  }
+}
+
+
+/**
+ * @brief Flags the cells of one parent row whose undivided gradient  |uᵢ₊₁ - uᵢ|  exceeds the threshold,  pads them
+ * by  `REFINEMENT_BUFFER_CELLS',  merges clusters closer than  `REFINEMENT_MERGE_GAP'  and appends one patch per
+ * cluster.
+ */
+static int
+refinement_Cluster (
+  const struct Parameters * parameters, struct Refinement * refinement, size_t level, struct Level * new_level,
+  size_t * capacity, const real_type * parent_row, const real_type * parent_positions, size_t parent_begin,
+  size_t parent_points, size_t parent
+)
+{
+  const size_t cells = parent_points - 1;
+  size_t cell = 0;
+  while (cell < cells)
+  {
+    if (! (fabs (parent_row [cell + 1] - parent_row [cell]) > refinement->threshold))
+    {
+      ++ cell;
+
+      continue;
+    }
+
+    const size_t first = cell > REFINEMENT_BUFFER_CELLS ? cell - REFINEMENT_BUFFER_CELLS : 0;
+    size_t last_flagged = cell;
+    size_t next = cell + 1;
+    while (next < cells && next - last_flagged <= REFINEMENT_MERGE_GAP + 2 * REFINEMENT_BUFFER_CELLS)
+    {
+      if (fabs (parent_row [next + 1] - parent_row [next]) > refinement->threshold)
+      {
+        last_flagged = next;
+      }
+      ++ next;
+    }
+    const size_t last =
+      last_flagged + REFINEMENT_BUFFER_CELLS < cells ? last_flagged + REFINEMENT_BUFFER_CELLS : cells - 1;
+
+    struct Patch * const patch = patch_Construct (
+      parameters, parent_positions + first, last + 2 - first, 2 * (parent_begin + first), parent,
+      refinement->levels [level].time_step
+    );
+    if (patch == NULL || refinement_Append (new_level, patch, capacity) != 0)
+    {
+      patch_Destroy (patch);
+
+      return - 1;
+    }
+
+    cell = last + 1 > next ? last + 1 : next;
+  }
+
+  return 0;
+}
+
+
+/**
+ * @brief Rebuilds every level from the one above it,  finest last.  `time_point'  is the current base time point.
+ */
+int
+refinement_Regrid (
+  const struct Parameters * parameters, struct Refinement * refinement, struct Mesh * base, size_t time_point
+)
+{
+  assert (refinement != NULL);
+  assert (base != NULL);
+
+  for (size_t level = 0; level < refinement->levels_count; ++ level)
+  {
+    struct Level * const old_level = & refinement->levels [level];
+    struct Level new_level = { .time_point = old_level->time_point, .time_step = old_level->time_step };
+    size_t capacity = 0;
+    int clustered = 0;
+    if (level == 0)
+    {
+      clustered = refinement_Cluster (
+        parameters, refinement, level, & new_level, & capacity,
+        & base->points [mesh_PointIndex (base, time_point, 0)], refinement->base_positions, 0,
+        refinement->base_points, 0
+      );
+    }
+    else
+    {
+      const struct Level * const parent_level = & refinement->levels [level - 1];
+      for (size_t parent = 0; parent < parent_level->patches_count && clustered == 0; ++ parent)
+      {
+        const struct Patch * const parent_patch = parent_level->patches [parent];
+        clustered = refinement_Cluster (
+          parameters, refinement, level, & new_level, & capacity,
+          & parent_patch->mesh->points [mesh_PointIndex (parent_patch->mesh, parent_level->time_point, 0)],
+          parent_patch->positions, parent_patch->begin, parent_patch->mesh->space_points, parent
+        );
+      }
+    }
+
+    if (clustered != 0)
+    {
+      for (size_t patch = 0; patch < new_level.patches_count; ++ patch)
+      {
+        patch_Destroy (new_level.patches [patch]);
+      }
+      free (new_level.patches);
+
+      return clustered;
+    }
+
+    for (size_t patch = 0; patch < new_level.patches_count; ++ patch)
+    {
+      size_t offset = 0;
+      const real_type * const parent_row = refinement_ParentRow (
+        refinement, level, new_level.patches [patch], base,
+        level == 0 ? time_point : refinement->levels [level - 1].time_point, & offset
+      );
+      refinement_Fill (
+        parameters, new_level.patches [patch], parent_row + offset, new_level.time_point,
+        old_level->patches, old_level->patches_count, old_level->time_point, time_point == 0
+      );
+    }
+
+    for (size_t patch = 0; patch < old_level->patches_count; ++ patch)
+    {
+      patch_Destroy (old_level->patches [patch]);
+    }
+    free (old_level->patches);
+    free (old_level->ranges);
+    * old_level = new_level;
+
+    const int balanced = refinement_Balance (old_level);
+    if (balanced != 0)
+    {
+      return balanced;
+    }
+  }
+
+  size_t patches = 0;
+  for (size_t level = 0; level < refinement->levels_count; ++ level)
+  {
+    patches += refinement->levels [level].patches_count;
+  }
+  refinement->patches_max = patches > refinement->patches_max ? patches : refinement->patches_max;
+  refinement->regrids += 1;
+
+  return 0;
+}
+
+
+/**
+ * @brief Takes the  `REFINEMENT_SUBSTEPS'  steps of a level that span one step of its parent,  starting at  `time',
+ * recursing into the finer level after each of them,  and injects the finer level back on completion.
+ * The first level is injected into the base mesh by  `solve'.
+ */
+static void
+refinement_Advance_Level (
+  const struct Parameters * parameters, struct Refinement * refinement, size_t level_index,
+  struct Mesh * base, size_t time_point, real_type time
+)
+{
+  struct Level * const level = & refinement->levels [level_index];
+  const size_t parent_time_point = level_index == 0 ? time_point : refinement->levels [level_index - 1].time_point;
+  for (size_t substep = 0; substep < REFINEMENT_SUBSTEPS; ++ substep)
+  {
+    level->time_point += 1;
+    const real_type substep_time = time + (real_type) substep * level->time_step;
+    for (size_t patch_index = 0; patch_index < level->patches_count; ++ patch_index)
+    {
+      struct Patch * const patch = level->patches [patch_index];
+      refinement_Interpolate_Ends (
+        refinement, level_index, patch, base, parent_time_point,
+        (real_type) (substep + 1) / REFINEMENT_SUBSTEPS,
+        & patch->mesh->points [mesh_PointIndex (patch->mesh, level->time_point, 0)]
+      );
+    }
+
+    for (size_t stage = 0; stage + 1 < METHOD_STAGES; ++ stage)
+    {
+      const real_type modulation =
+        parameters->source_modulation != NULL
+          ? parameters->source_modulation (substep_time + method_nodes [stage] * level->time_step)
+          : 1.0;
+#ifdef WITH_OMP
+#pragma omp parallel for schedule(static)
+#endif  // WITH_OMP
+      for (size_t range_index = 0; range_index < level->ranges_count; ++ range_index)
+      {
+        const struct PatchRange * const range = & level->ranges [range_index];
+        const struct Patch * const patch = level->patches [range->patch];
+        method_Stage (
+          stage,
+          & patch->mesh->points [mesh_PointIndex (patch->mesh, level->time_point - 1, 0)],
+          & patch->mesh->points [mesh_PointIndex (patch->mesh, level->time_point, 0)],
+          patch->stage_rows, patch->coefficients, 0.0, modulation, range->begin, range->end, 0
+        );
+      }
+
+      for (size_t patch_index = 0; patch_index < level->patches_count; ++ patch_index)
+      {
+        struct Patch * const patch = level->patches [patch_index];
+        refinement_Interpolate_Ends (
+          refinement, level_index, patch, base, parent_time_point,
+          ((real_type) substep + method_nodes [stage + 1]) / REFINEMENT_SUBSTEPS, patch->stage_rows [stage % 2]
+        );
+      }
+    }
+
+    const real_type modulation =
+      parameters->source_modulation != NULL
+        ? parameters->source_modulation (substep_time + method_nodes [METHOD_STAGES - 1] * level->time_step)
+        : 1.0;
+    const real_type weight = method_weights [METHOD_STAGES - 1];
+#ifdef WITH_OMP
+#pragma omp parallel for schedule(static)
+#endif  // WITH_OMP
+    for (size_t range_index = 0; range_index < level->ranges_count; ++ range_index)
+    {
+      const struct PatchRange * const range = & level->ranges [range_index];
+      const struct Patch * const patch = level->patches [range->patch];
+      const real_type * const previous_row =
+        & patch->mesh->points [mesh_PointIndex (patch->mesh, level->time_point - 1, 0)];
+      real_type * const current_row = & patch->mesh->points [mesh_PointIndex (patch->mesh, level->time_point, 0)];
+      const real_type * restrict const input_row =
+        method_Input (previous_row, patch->stage_rows, METHOD_STAGES - 1);
+      const real_type * const partial_row = METHOD_STAGES > 1 ? current_row : previous_row;
+      for (size_t space_point = range->begin; space_point < range->end; ++ space_point)
+      {
+        current_row [space_point] =
+          partial_row [space_point] + weight * stencil_Flux (input_row, patch->coefficients, modulation, space_point);
+      }
+    }
+
+    for (size_t range_index = 0; range_index < level->ranges_count; ++ range_index)
+    {
+      refinement->point_updates += level->ranges [range_index].end - level->ranges [range_index].begin;
+    }
+
+    if (level_index + 1 < refinement->levels_count)
+    {
+      refinement_Advance_Level (parameters, refinement, level_index + 1, base, time_point, substep_time);
+    }
+  }
+
+  if (level_index == 0)
+  {
+    return;
+  }
+
+  for (size_t patch_index = 0; patch_index < level->patches_count; ++ patch_index)
+  {
+    const struct Patch * const patch = level->patches [patch_index];
+    size_t offset = 0;
+    real_type * const parent_row = refinement_ParentRow (
+      refinement, level_index, patch, base, parent_time_point, & offset
+    );
+    const size_t last = patch->mesh->space_points - 1;
+    for (size_t point = 2; point < last; point += 2)
+    {
+      parent_row [offset + point / 2] = mesh_Get (patch->mesh, level->time_point, point);
+    }
+  }
+}
+
+
+/**
+ * @brief Advances all levels from base time point  `time_point - 1'  to  `time_point'.
+ */
+void
+refinement_Advance (
+  const struct Parameters * parameters, struct Refinement * refinement, struct Mesh * base, size_t time_point,
+  real_type time
+)
+{
+  assert (refinement != NULL);
+  assert (time_point > 0);
+
+  if (refinement->levels_count > 0)
+  {
+    refinement_Advance_Level (parameters, refinement, 0, base, time_point, time);
+  }
+}
+
+
+typedef int refinement_visitor_type (
+  const struct Parameters * parameters, const struct Refinement * refinement, size_t time_point
+);
+
+
+int
+refinement_Write_Statistics (
+  const struct Refinement * refinement, FILE * output, size_t base_points, size_t base_time_steps
+)
+{
+  assert (refinement != NULL);
+  assert (output != NULL);
+
+  size_t patches = 0;
+  size_t points = 0;
+  for (size_t level = 0; level < refinement->levels_count; ++ level)
+  {
+    patches += refinement->levels [level].patches_count;
+    for (size_t patch = 0; patch < refinement->levels [level].patches_count; ++ patch)
+    {
+      points += refinement->levels [level].patches [patch]->mesh->space_points;
+    }
+  }
+
+  /*
+   * Point updates a uniform grid at the finest resolution would need.
+   */
+  double uniform_point_updates = (double) (base_points - 2) * (double) base_time_steps;
+  for (size_t level = 0; level < refinement->levels_count; ++ level)
+  {
+    uniform_point_updates *= 2.0 * REFINEMENT_SUBSTEPS;
+  }
+
+  return fprintf (
+    output,
+    "Refinement{levels=%zu;regrids=%zu;patches=%zu;patches_max=%zu;points=%zu;point_updates=%zu;uniform_point_updates=%.0f;}",
+    refinement->levels_count, refinement->regrids, patches, refinement->patches_max, points,
+    refinement->point_updates + (base_points - 2) * base_time_steps, uniform_point_updates
+  );
+}
+
+
+/**
+ * @brief Releases whatever  `solve'  has constructed so far;  any argument may be  `NULL'.
+ */
+static void
+solve_Release (
+  struct Mesh * mesh, real_type * positions, real_type * stage_rows, struct Coefficients * coefficients,
+  struct Refinement * refinement, struct AnalyticSolution * analytic_solution
+)
+{
+  analyticSolution_Destroy (analytic_solution);
+  refinement_Destroy (refinement);
+  coefficients_Destroy (coefficients);
+  realArray_Destroy (stage_rows);
+  realArray_Destroy (positions);
+  mesh_Destroy (mesh);
+}
+
+
+/**
+ * @brief With  `WITH_ANALYTICS'  the per-step  `struct Analytics'  reductions are fused into the update loop as
+ * OpenMP reductions and passed to  `on_analytics';  otherwise  `on_analytics'  must be  `NULL'.  The L2 error is
+ * the exception:  when due it takes a pass of its own over the new row  (see  `analytics_Error').
+ * With α(x),  q(x)  or a graded grid the coefficients are precomputed once into  `struct Coefficients'  and the
+ * flux-form kernel is used;  otherwise  (or when α(x) turns out constant)  the scalar-r kernel is.
+ * With  `refinement_levels'  the refined levels are advanced after every base step and injected into it,  and
+ * `after_refinement'  is passed the final hierarchy.
+ */
+int
+solve (
+  const struct Parameters * parameters,
+  solution_visitor_type * before_solution, solution_visitor_type * on_solution, solution_visitor_type * after_solution,
+  analytics_visitor_type * on_analytics, refinement_visitor_type * after_refinement
+)
+{
+  assert (parameters != NULL);
+#ifndef WITH_ANALYTICS
+  assert (on_analytics == NULL);
+#endif  // WITH_ANALYTICS
+
+  if (before_solution != NULL)
+  {
+    const int visited = before_solution (parameters, NULL, - 1);
+    if (visited != 0)
+    {
+      fprintf (stderr, "Error: something went wrong.\n");
+
+      return visited;
+    }
+  }
+
+  struct Mesh * const mesh = mesh_Construct (2, parameters->space_points);
+  if (mesh == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for mesh.\n");
+
+    return - 1;
+  }
+
+  /*
+   * Both grids include their end points:  xᵢ = i L / (N - 1)  unless graded,  tⱼ = j T / (M - 1).
+   */
+  const real_type time_step = parameters->time_max / (real_type) (parameters->time_points - 1);
+  const real_type space_step = parameters->space_max / (real_type) (parameters->space_points - 1);
+  real_type * const positions = realArray_Allocate (mesh->space_points);
+  if (positions == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for positions.\n");
+
+    solve_Release (mesh, NULL, NULL, NULL, NULL, NULL);
+
+    return - 1;
+  }
+
+  for (size_t space_point = 0; space_point < mesh->space_points; ++ space_point)
+  {
+    positions [space_point] = parameters_Space (parameters, space_point);
+  }
+
+  /*
+   * Inputs of the inner stages of the method;  their end points keep the boundary conditions.
+   */
+  real_type * stage_rows [2] = { NULL, NULL };
+  if (METHOD_STAGES > 1)
+  {
+    stage_rows [0] = realArray_Allocate (2 * mesh->space_points);
+    if (stage_rows [0] == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for stages.\n");
+
+      solve_Release (mesh, positions, NULL, NULL, NULL, NULL);
+
+      return - 1;
+    }
+
+    stage_rows [1] = stage_rows [0] + mesh->space_points;
+    for (size_t stage_row = 0; stage_row < 2; ++ stage_row)
+    {
+      stage_rows [stage_row] [0] = parameters->boundary_condition_0;
+      stage_rows [stage_row] [mesh->space_points - 1] = parameters->boundary_condition_1;
+    }
+  }
+
+  struct Coefficients * coefficients = NULL;
+  real_type diffusivity = parameters->diffusivity;
+  if (
+       parameters->diffusivity_profile != NULL || parameters->source_profile != NULL
+    || parameters->grid_grading > 0.0
+  )
+  {
+    coefficients = coefficients_Construct (parameters, positions, mesh->space_points, time_step);
+    if (coefficients == NULL)
+    {
+      fprintf (stderr, "Error: couldn't construct coefficients.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], NULL, NULL, NULL);
+
+      return - 1;
+    }
+
+    diffusivity = coefficients->diffusivity_max;
+    if (coefficients_IsUniform (coefficients, parameters))
+    {
+      coefficients_Destroy (coefficients);
+      coefficients = NULL;
+    }
+  }
+
+  struct Refinement * refinement = NULL;
+  if (parameters->refinement_levels > 0)
+  {
+    refinement = refinement_Construct (parameters, positions, time_step);
+    if (refinement == NULL)
+    {
+      fprintf (stderr, "Error: couldn't construct refinement.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, NULL, NULL);
+
+      return - 1;
+    }
+  }
+
+  struct AnalyticSolution * analytic_solution = NULL;
+#ifdef WITH_ANALYTICS
+  /*
+   * The series is by far the dearest part of the analytics  (its coefficients alone are a quadrature over the
+   * whole rod per mode):  only built when there is someone to report the error to.
+   */
+  const int error_possible =
+    on_analytics != NULL && parameters->diffusivity_profile == NULL && parameters->source_profile == NULL;
+  if (error_possible)
+  {
+    analytic_solution = analyticSolution_Construct (parameters);
+    if (analytic_solution == NULL)
+    {
+      fprintf (stderr, "Error: couldn't construct analytic solution.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, NULL);
+
+      return - 1;
+    }
+
+    analyticSolution_Advance (analytic_solution, 0.0);
+  }
+
+  const real_type diffusivity_0 =
+    parameters->diffusivity_profile != NULL ? parameters->diffusivity_profile (0.0) : parameters->diffusivity;
+  const real_type diffusivity_1 =
+    parameters->diffusivity_profile != NULL
+      ? parameters->diffusivity_profile (parameters->space_max)
+      : parameters->diffusivity;
+  struct Analytics analytics = { .temperature_min = INFINITY, .temperature_max = - INFINITY };
+#endif  // WITH_ANALYTICS
+  mesh_Set (mesh, 0, 0, parameters->boundary_condition_0);
+  mesh_Set (mesh, 0, mesh->space_points - 1, parameters->boundary_condition_1);
+  for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
+  {
+    const real_type space = positions [space_point];
+    const real_type temperature = parameters->initial_condition (space);
+    mesh_Set (mesh, 0, space_point, temperature);
+#ifdef WITH_ANALYTICS
+    analytics_Accumulate (
+      & analytics.temperature_min, & analytics.temperature_max, & analytics.energy,
+      0.5 * (positions [space_point + 1] - positions [space_point - 1]), temperature
+    );
+#endif  // WITH_ANALYTICS
+  }
+
+  if (refinement != NULL)
+  {
+    const int regridded = refinement_Regrid (parameters, refinement, mesh, 0);
+    if (regridded != 0)
+    {
+      fprintf (stderr, "Error: couldn't regrid.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+      return regridded;
+    }
+  }
+
+#ifdef WITH_ANALYTICS
+  analytics_Complete (& analytics, mesh, 0, 0.0, positions, diffusivity_0, diffusivity_1);
+  analytics.error_l2 =
+    error_possible ? analytics_Error (analytic_solution, mesh, 0, positions) : (real_type) NAN;
+  if (on_analytics != NULL)
+  {
+    const int visited = on_analytics (parameters, & analytics, 0);
+    if (visited != 0)
+    {
+      fprintf (stderr, "Error: something went wrong.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+      return visited;
+    }
+  }
+#endif  // WITH_ANALYTICS
+
+  if (on_solution != NULL)
+  {
+    const int visited = on_solution (parameters, mesh, 0);
+    if (visited != 0)
+    {
+      fprintf (stderr, "Error: something went wrong.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+      return visited;
+    }
+  }
+
+  /*
+   * Stability bound with the largest α:  the spectrum lies in  [-4r, 0],  r = αΔt/Δx²,  on the uniform grid and in
+   * [-2 max wᵢ(F₀ + F₁), 0]  otherwise.
+   */
+  const real_type r = diffusivity * (time_step / pow (space_step, 2.0));
+  assert (
+    coefficients != NULL
+      ? 2.0 * coefficients->stability <= METHOD_STABILITY_LIMIT
+      : 4.0 * r <= METHOD_STABILITY_LIMIT
+  );
+  for (size_t time_point = 1; time_point < parameters->time_points; ++ time_point)
+  {
+    mesh_Set (mesh, time_point, 0, parameters->boundary_condition_0);
+    mesh_Set (mesh, time_point, mesh->space_points - 1, parameters->boundary_condition_1);
+    const real_type time = (real_type) time_point * time_step;
+#ifdef WITH_ANALYTICS
+    const int error_due = error_possible && time_point % ANALYTICS_ERROR_EVERY_NTH_SOLUTION == 0;
+    if (error_due)
+    {
+      analyticSolution_Advance (analytic_solution, time);
+    }
+    real_type temperature_min = INFINITY;
+    real_type temperature_max = - INFINITY;
+    real_type energy = 0.0;
+#endif  // WITH_ANALYTICS
+    const real_type * const previous_row = & mesh->points [mesh_PointIndex (mesh, time_point - 1, 0)];
+    real_type * const current_row = & mesh->points [mesh_PointIndex (mesh, time_point, 0)];
+    for (size_t stage = 0; stage + 1 < METHOD_STAGES; ++ stage)
+    {
+      method_Stage (
+        stage, previous_row, current_row, stage_rows, coefficients, r,
+        parameters->source_modulation != NULL
+          ? parameters->source_modulation (time - time_step + method_nodes [stage] * time_step)
+          : 1.0,
+        1, mesh->space_points - 1, 1
+      );
+    }
+
+    /*
+     * The last stage:  uᵢ + Σ bₛkₛ  written straight into the new row.
+     */
+    const real_type * restrict const input_row = method_Input (previous_row, stage_rows, METHOD_STAGES - 1);
+    const real_type * const partial_row = METHOD_STAGES > 1 ? current_row : previous_row;
+    const real_type weight = method_weights [METHOD_STAGES - 1];
+    if (coefficients != NULL)
+    {
+      /*
+       * g(tₙ + cₛΔt)  of the explicit step  tₙ → tₙ₊₁.
+       */
+      const real_type modulation =
+        parameters->source_modulation != NULL
+          ? parameters->source_modulation (time - time_step + method_nodes [METHOD_STAGES - 1] * time_step)
+          : 1.0;
+#if defined (WITH_OMP) && defined (WITH_ANALYTICS)
+#pragma omp parallel for simd reduction(min:temperature_min) reduction(max:temperature_max) reduction(+:energy)
+#elif defined (WITH_OMP)
+#pragma omp parallel for simd
+#endif  // defined (WITH_OMP) && defined (WITH_ANALYTICS)
+      for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
+      {
+        const real_type temperature =
+          partial_row [space_point] + weight * stencil_Flux (input_row, coefficients, modulation, space_point);
+        current_row [space_point] = temperature;
+#ifdef WITH_ANALYTICS
+        analytics_Accumulate (
+          & temperature_min, & temperature_max, & energy,
+          0.5 * (positions [space_point + 1] - positions [space_point - 1]), temperature
+        );
+#endif  // WITH_ANALYTICS
+      }
+    }
+    else
+    {
+#if defined (WITH_OMP) && defined (WITH_ANALYTICS)
+#pragma omp parallel for simd reduction(min:temperature_min) reduction(max:temperature_max) reduction(+:energy)
+#elif defined (WITH_OMP)
+#pragma omp parallel for simd
+#endif  // defined (WITH_OMP) && defined (WITH_ANALYTICS)
+      for (size_t space_point = 1; space_point < mesh->space_points - 1; ++ space_point)
+      {
+        /*
+         * Time:  explicit Euler or 4-th order Runge-Kutta method  (method of lines).
+         * Space:  2nd order central difference.
+         */
+        const real_type temperature =
+          partial_row [space_point] + weight * stencil_Scalar (input_row, r, space_point);
+        current_row [space_point] = temperature;
+#ifdef WITH_ANALYTICS
+        /*
+         * Fused with the update:  the new value is still in a register,  no second pass over the row.
+         */
+        analytics_Accumulate (& temperature_min, & temperature_max, & energy, space_step, temperature);
+#endif  // WITH_ANALYTICS
+      }
+    }
+
+    if (refinement != NULL)
+    {
+      refinement_Advance (parameters, refinement, mesh, time_point, time - time_step);
+
+      /*
+       * Injection of the first level;  the fused energy is corrected by the change of each injected point,  while
+       * the extrema only see the new values:  a pre-injection extremum lingers,  see  `struct Analytics'.
+       */
+      const struct Level * const level = & refinement->levels [0];
+      for (size_t patch_index = 0; patch_index < level->patches_count; ++ patch_index)
+      {
+        const struct Patch * const patch = level->patches [patch_index];
+        const size_t offset = patch->begin / 2;
+        const size_t last = patch->mesh->space_points - 1;
+        for (size_t point = 2; point < last; point += 2)
+        {
+          const size_t space_point = offset + point / 2;
+          const real_type temperature = mesh_Get (patch->mesh, level->time_point, point);
+#ifdef WITH_ANALYTICS
+          const real_type cell_width = 0.5 * (positions [space_point + 1] - positions [space_point - 1]);
+          const real_type coarse = mesh_Get (mesh, time_point, space_point);
+          temperature_min = temperature < temperature_min ? temperature : temperature_min;
+          temperature_max = temperature > temperature_max ? temperature : temperature_max;
+          energy += cell_width * (temperature - coarse);
+#endif  // WITH_ANALYTICS
+          mesh_Set (mesh, time_point, space_point, temperature);
+        }
+      }
+
+      if (time_point % REGRID_EVERY_NTH_SOLUTION == 0)
+      {
+        const int regridded = refinement_Regrid (parameters, refinement, mesh, time_point);
+        if (regridded != 0)
+        {
+          fprintf (stderr, "Error: couldn't regrid.\n");
+
+          solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+          return regridded;
+        }
+      }
+    }
+
+#ifdef WITH_ANALYTICS
+    analytics.temperature_min = temperature_min;
+    analytics.temperature_max = temperature_max;
+    analytics.energy = energy;
+    analytics_Complete (& analytics, mesh, time_point, time, positions, diffusivity_0, diffusivity_1);
+    analytics.error_l2 =
+      error_due ? analytics_Error (analytic_solution, mesh, time_point, positions) : (real_type) NAN;
+    if (on_analytics != NULL)
+    {
+      const int visited = on_analytics (parameters, & analytics, time_point);
+      if (visited != 0)
+      {
+        fprintf (stderr, "Error: something went wrong.\n");
+
+        solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+        return visited;
+      }
+    }
+#endif  // WITH_ANALYTICS
+
+    if (on_solution != NULL)
+    {
+      const int visited = on_solution (parameters, mesh, time_point);
+      if (visited != 0)
+      {
+        fprintf (stderr, "Error: something went wrong.\n");
+
+        solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+        return visited;
+      }
+    }
+  }
+
+  if (refinement != NULL && after_refinement != NULL)
+  {
+    const int visited = after_refinement (parameters, refinement, parameters->time_points - 1);
+    if (visited != 0)
+    {
+      fprintf (stderr, "Error: something went wrong.\n");
+
+      solve_Release (mesh, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+      return visited;
+    }
+  }
+  solve_Release (NULL, positions, stage_rows [0], coefficients, refinement, analytic_solution);
+
+  if (after_solution != NULL)
+  {
+    const int visited = after_solution (parameters, mesh, parameters->time_points - 1);
+    if (visited != 0)
+    {
+      fprintf (stderr, "Error: something went wrong.\n");
+
+      mesh_Destroy (mesh);
+
+      return visited;
+    }
+  }
+
+  mesh_Destroy (mesh);
+
+  return 0;
+}
+
+
+int
+writeSolution_Stdout (const struct Parameters * parameters_, const struct Mesh * mesh, size_t time_point)
+{
+  fprintf (stdout, "time_point=%zu;\n", time_point);
+  mesh_Write_File (mesh, stdout, "%f");
+//  mesh_Write_File_Formatted (mesh, stdout, "\t% f");
+//  mesh_Write_File_Formatted_AtTimePoint (mesh, stdout, "\t% f", time_point);
+  fprintf (stdout, ";\n");
+
+  return 0;
+}
+
+
+int
+writeRefinementStatistics_Stdout (
+  const struct Parameters * parameters, const struct Refinement * refinement, size_t time_point
+)
+{
+  refinement_Write_Statistics (refinement, stdout, parameters->space_points, time_point);
+  fprintf (stdout, ";\n");
+
+  return 0;
+}
+
+
+#define PLOT_EVERY_NTH_SOLUTION (10)
+#define GNUPLOT_SCRIPT_NAME ("plot.gp")
+#define GNUPLOT_SCRIPT_TEMPLATE ( \
+  "set terminal wxt persist\n" \
+  "set xlabel 'Space (x)'\n" \
+  "set ylabel 'Temperature (u(x))'\n" \
+  "#set offsets graph 0.01, 0.01, 0.01, 0.01\n" \
+  "set grid xtics ytics\n" \
+  "set style fill transparent solid 0.333\n" \
+  "filename(x) = sprintf(\"%%d.dat\", x)\n" \
+  "set key autotitle columnhead\n" \
+  "plot for [i = 0:%zu:%zu] filename(i) using 1:2 with lines\n" \
+)
+
+
+int
+writeGnuplotScript_File (const struct Parameters * parameters, const struct Mesh * mesh_, size_t time_point_)
+{
+  FILE * const output = fopen (GNUPLOT_SCRIPT_NAME, "w");
+  if (output == NULL)
+  {
+    fprintf (stderr, "Error: couldn't open output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+
+    return - 1;
+  }
+
+  fprintf (output, GNUPLOT_SCRIPT_TEMPLATE, parameters->time_points - 1, PLOT_EVERY_NTH_SOLUTION);
+
+  const int flushed = fflush (output);
+  if (flushed != 0)
+  {
+    fprintf (stderr, "Error: couldn't flush output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+
+    return flushed;
+  }
+
+  const int closed = fclose (output);
+  if (closed != 0)
+  {
+    fprintf (stderr, "Error: couldn't close output file (%s).\n", GNUPLOT_SCRIPT_NAME);
+
+    return closed;
+  }
+
+  return 0;
+}
+
+
+#define SOLUTION_FILENAME_BUFFER_LENGTH (48)
+#define WRITE_EVERY_NTH_SOLUTION (10)
+
+
+int
+writeSolution_File (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point)
+{
+  if (time_point % WRITE_EVERY_NTH_SOLUTION != 0)
+  {
+    return 0;
+  }
+
+  static char filename [SOLUTION_FILENAME_BUFFER_LENGTH];
+  sprintf (filename, "%zu.dat", time_point);
+  FILE * const output = fopen (filename, "w");
+  if (output == NULL)
+  {
+    fprintf (stderr, "Error: couldn't open output file (%s).\n", filename);
+
+    return - 1;
+  }
+
+  const real_type time = lerp (
+    (real_type) time_point, 0.0, (real_type) (parameters->time_points - 1), 0.0, parameters->time_max
+  );
+  fprintf (output, "x \"u(x, %g)\"\n", time);
+  fprintf (output, "# ");
+  parameters_Write_File (parameters, output);
+  fprintf (output, ";\n");
+  fprintf (output, "# time=%f;time_point=%zu;\n", time, time_point);
+  fprintf (output, "# space;temperature;\n");
+
+  for (size_t space_point = 0; space_point < parameters->space_points; ++ space_point)
+  {
+    const real_type space = parameters_Space (parameters, space_point);
+    const real_type temperature = mesh_Get (mesh, time_point, space_point);
+    fprintf (output, "%.*f %.*f\n", DECIMAL_DIG, space, DECIMAL_DIG, temperature);
+  }
+
+  const int flushed = fflush (output);
+  if (flushed != 0)
+  {
+    fprintf (stderr, "Error: couldn't flush output file (%s).\n", filename);
+
+    return flushed;
+  }
+
+  const int closed = fclose (output);
+  if (closed != 0)
+  {
+    fprintf (stderr, "Error: couldn't close output file (%s).\n", filename);
+
+    return closed;
+  }
+
+  return 0;
+}
+
+
+static inline double
+wallTime (void)
+{
+#ifdef WITH_OMP
+  return omp_get_wtime ();
+#else  // WITH_OMP
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif  // WITH_OMP
+}
+
+
+static inline uint64_t
+real_ToBits (real_type value)
+{
+  uint64_t bits;
+  memcpy (& bits, & value, sizeof (bits));
+
+  return bits;
+}
+
+
+static inline real_type
+real_FromBits (uint64_t bits)
+{
+  real_type value;
+  memcpy (& value, & bits, sizeof (value));
+
+  return value;
+}
+
+
+/**
+ * @brief Predicts a point of the current snapshot from the previous snapshot and the already coded left neighbour
+ * (Lorenzo predictor over the  (time, space)  plane).
+ */
+static inline real_type
+compressor_Predict (const real_type * previous, real_type current_left, size_t point)
+{
+  if (point == 0)
+  {
+    return previous [0];
+  }
+
+  return previous [point] + (current_left - previous [point - 1]);
+}
+
+
+/**
+ * @brief Lossless codec:  XOR of the IEEE 754 bits with the prediction, stored as its significant low-order bytes.
+ * Byte counts of two consecutive points share one header byte  (low & high nibble).
+ */
+static size_t
+compressor_Encode_Lossless (
+  const real_type * restrict current, const real_type * restrict previous, size_t points,
+  unsigned char * restrict bytes, real_type * restrict reconstructed
+)
+{
+  size_t length = 0;
+  size_t header = 0;
+  for (size_t point = 0; point < points; ++ point)
+  {
+    const real_type predicted = compressor_Predict (previous, point == 0 ? 0.0 : current [point - 1], point);
+    const uint64_t residual = real_ToBits (current [point]) ^ real_ToBits (predicted);
+    const unsigned int significant =
+      residual == 0 ? 0 : sizeof (residual) - (unsigned int) __builtin_clzll (residual) / 8;
+    if (point % 2 == 0)
+    {
+      header = length;
+      bytes [length ++] = (unsigned char) significant;
+    }
+    else
+    {
+      bytes [header] |= (unsigned char) (significant << 4);
+    }
+
+    for (unsigned int byte = 0; byte < significant; ++ byte)
+    {
+      bytes [length ++] = (unsigned char) (residual >> (8 * byte));
+    }
+
+    reconstructed [point] = current [point];
+  }
+
+  return length;
+}
+
+
+#define COMPRESSOR_QUANT_MAX (4.0e18)
+
+
+static inline size_t
+compressor_Write_Varint (unsigned char * restrict bytes, uint64_t code)
+{
+  size_t length = 0;
+  while (code >= 0x80)
+  {
+    bytes [length ++] = (unsigned char) (code | 0x80);
+    code >>= 7;
+  }
+  bytes [length ++] = (unsigned char) code;
+
+  return length;
+}
+
+
+#define COMPRESSOR_VARINT_BYTES_MAX (10)
+
+
+/**
+ * @brief Inverse of  `compressor_Write_Varint'  reading at most  `available'  bytes;  returns the count of bytes
+ * consumed,  or 0 for a truncated varint or one that doesn't fit 64 bits.
+ */
+static inline size_t
+compressor_Read_Varint (const unsigned char * restrict bytes, size_t available, uint64_t * code)
+{
+  size_t length = 0;
+  unsigned int shift = 0;
+  unsigned char byte;
+  * code = 0;
+  do
+  {
+    if (length == available || length == COMPRESSOR_VARINT_BYTES_MAX)
+    {
+      return 0;
+    }
+    byte = bytes [length ++];
+    if (length == COMPRESSOR_VARINT_BYTES_MAX && byte > 1)
+    {
+      return 0;
+    }
+    * code |= (uint64_t) (byte & 0x7F) << shift;
+    shift += 7;
+  }
+  while ((byte & 0x80) != 0);
+
+  return length;
+}
+
+
+#define COMPRESSOR_CODE_ESCAPE (0)
+#define COMPRESSOR_CODE_ZERO_RUN (COMPRESSOR_CODE_ESCAPE + 1)
+#define COMPRESSOR_CODE_QUANTUM (COMPRESSOR_CODE_ZERO_RUN + 1)
+
+
+/**
+ * @brief Error-bounded lossy codec:  the prediction residual is quantized with step 2ε, zigzag-mapped and stored as a
+ * varint.  Runs of zero quanta collapse into one code plus a run length;  an escape code stores a raw value whenever
+ * quantization would overflow or miss the bound.
+ */
+static size_t
+compressor_Encode_Lossy (
+  const real_type * restrict current, const real_type * restrict previous, size_t points, real_type tolerance,
+  unsigned char * restrict bytes, real_type * restrict reconstructed
+)
+{
+  const real_type quantum = 2.0 * tolerance;
+  size_t length = 0;
+  uint64_t zero_run = 0;
+  for (size_t point = 0; point < points; ++ point)
+  {
+    const real_type predicted =
+      compressor_Predict (previous, point == 0 ? 0.0 : reconstructed [point - 1], point);
+    const real_type quotient = (current [point] - predicted) / quantum;
+    int escaped = ! (fabs (quotient) < COMPRESSOR_QUANT_MAX);
+    int64_t quantized = 0;
+    if (! escaped)
+    {
+      quantized = llround (quotient);
+      reconstructed [point] = predicted + (real_type) quantized * quantum;
+      escaped = ! (fabs (reconstructed [point] - current [point]) <= tolerance);
+    }
+
+    if (! escaped && quantized == 0)
+    {
+      reconstructed [point] = predicted;
+      ++ zero_run;
+
+      continue;
+    }
+
+    if (zero_run != 0)
+    {
+      length += compressor_Write_Varint (bytes + length, COMPRESSOR_CODE_ZERO_RUN);
+      length += compressor_Write_Varint (bytes + length, zero_run);
+      zero_run = 0;
+    }
+
+    if (escaped)
+    {
+      const uint64_t bits = real_ToBits (current [point]);
+      length += compressor_Write_Varint (bytes + length, COMPRESSOR_CODE_ESCAPE);
+      for (unsigned int byte = 0; byte < sizeof (bits); ++ byte)
+      {
+        bytes [length ++] = (unsigned char) (bits >> (8 * byte));
+      }
+      reconstructed [point] = current [point];
+
+      continue;
+    }
+
+    const uint64_t zigzag = ((uint64_t) quantized << 1) ^ (uint64_t) (quantized >> 63);
+    length += compressor_Write_Varint (bytes + length, zigzag + COMPRESSOR_CODE_QUANTUM);
+  }
+
+  if (zero_run != 0)
+  {
+    length += compressor_Write_Varint (bytes + length, COMPRESSOR_CODE_ZERO_RUN);
+    length += compressor_Write_Varint (bytes + length, zero_run);
+  }
+
+  return length;
+}
+
+
+/**
+ * @brief Inverse of  `compressor_Encode_*'  for one chunk of  `length'  bytes;  returns 0 when it decodes to exactly
+ * `points'  values using all of them,  - 1 for a corrupted chunk.  Every read is bounded by  `length'.
+ */
+int
+compressor_Decode_Chunk (
+  const unsigned char * restrict bytes, size_t length, const real_type * restrict previous, size_t points,
+  real_type tolerance, real_type * restrict current
+)
+{
+  const real_type quantum = 2.0 * tolerance;
+  size_t read = 0;
+  unsigned int header = 0;
+  uint64_t zero_run = 0;
+  for (size_t point = 0; point < points; ++ point)
+  {
+    const real_type predicted = compressor_Predict (previous, point == 0 ? 0.0 : current [point - 1], point);
+    if (tolerance > 0.0)
+    {
+      uint64_t code = COMPRESSOR_CODE_ZERO_RUN;
+      if (zero_run == 0)
+      {
+        const size_t code_length = compressor_Read_Varint (bytes + read, length - read, & code);
+        if (code_length == 0)
+        {
+          return - 1;
+        }
+        read += code_length;
+        if (code == COMPRESSOR_CODE_ZERO_RUN)
+        {
+          const size_t run_length = compressor_Read_Varint (bytes + read, length - read, & zero_run);
+          if (run_length == 0 || zero_run == 0)
+          {
+            return - 1;
+          }
+          read += run_length;
+        }
+      }
+
+      if (code == COMPRESSOR_CODE_ZERO_RUN)
+      {
+        -- zero_run;
+        current [point] = predicted;
+      }
+      else if (code == COMPRESSOR_CODE_ESCAPE)
+      {
+        uint64_t bits = 0;
+        if (length - read < sizeof (bits))
+        {
+          return - 1;
+        }
+        for (unsigned int index = 0; index < sizeof (bits); ++ index)
+        {
+          bits |= (uint64_t) bytes [read ++] << (8 * index);
+        }
+        current [point] = real_FromBits (bits);
+      }
+      else
+      {
+        code -= COMPRESSOR_CODE_QUANTUM;
+        const int64_t quantized = (int64_t) (code >> 1) ^ - (int64_t) (code & 1);
+        current [point] = predicted + (real_type) quantized * quantum;
+      }
+    }
+    else
+    {
+      if (point % 2 == 0)
+      {
+        if (read == length)
+        {
+          return - 1;
+        }
+        header = bytes [read ++];
+      }
+      const unsigned int significant = point % 2 == 0 ? header & 0x0F : header >> 4;
+      if (significant > sizeof (uint64_t) || length - read < significant)
+      {
+        return - 1;
+      }
+      uint64_t residual = 0;
+      for (unsigned int byte = 0; byte < significant; ++ byte)
+      {
+        residual |= (uint64_t) bytes [read ++] << (8 * byte);
+      }
+      current [point] = real_FromBits (real_ToBits (predicted) ^ residual);
+    }
+  }
+
+  /*
+   * A zero run past the chunk,  trailing bytes,  or a second nibble where the chunk has none.
+   */
+  const int odd_header = tolerance > 0.0 || points % 2 == 0 ? 0 : (header >> 4) != 0;
+
+  return zero_run == 0 && read == length && ! odd_header ? 0 : - 1;
+}
+
+
+#define COMPRESSOR_CHUNK_POINTS (4096)
+#define COMPRESSOR_CHUNK_BYTES_PER_POINT (11)
+/*
+ * The writer thread's team runs alongside the solver's,  so it only takes this fraction  (1 / share)  of the threads:
+ * more would steal cores from the solver,  which waits on the writer only when it falls a whole snapshot behind.
+ */
+#define COMPRESSOR_WRITER_THREADS_SHARE (4)
+
+
+/**
+ * @brief Compressed snapshot sink.
+ * File layout:  `# Parameters{...};\n'  and the tolerance as  `uint64'  bits  (the text rounds it,  the decoder needs
+ * the encoder's exact quantum),  then per snapshot  `uint64 time_point',  `uint32 length'  per chunk and the
+ * chunk payloads.  Chunks are coded independently against the previous  (reconstructed)  snapshot.
+ */
+struct Compressor
+{
+  FILE * output;
+
+  real_type * previous;
+
+  real_type * reconstructed;
+
+  /**
+   * @brief Copy of the snapshot handed to the writer thread,  see  `compressor_Submit_Snapshot'.
+   */
+  real_type * pending;
+
+  size_t pending_time_point;
+
+  /**
+   * @brief Whether  `pending'  holds a snapshot the writer hasn't finished yet.
+   */
+  int pending_full;
+
+  int closing;
+
+  /**
+   * @brief Result of the last snapshot written by the writer thread.
+   */
+  int status;
+
+  int writer_started;
+
+  /**
+   * @brief Size of the team the writer thread encodes the chunks with,  see  `COMPRESSOR_WRITER_THREADS_SHARE'.
+   */
+  size_t writer_threads;
+
+  pthread_t writer;
+
+  pthread_mutex_t mutex;
+
+  pthread_cond_t condition;
+
+#ifndef NDEBUG
+  real_type * decoded;
+#endif  // NDEBUG
+
+  unsigned char * chunk_bytes;
+
+  uint32_t * chunk_lengths;
+
+  size_t chunk_capacity;
+
+  size_t chunk_points;
+
+  size_t chunks_count;
+
+  size_t space_points;
+
+  real_type tolerance;
+
+  size_t snapshots;
+
+  size_t compressed_bytes;
+
+  double encode_seconds;
+
+  double write_seconds;
+
+  /**
+   * @brief Time the solver spent waiting for the writer thread.
+   */
+  double wait_seconds;
+};
+
+
+struct Compressor *
+compressor_Allocate (void)
+{
+  const size_t bytes = sizeof (struct Compressor);
+  struct Compressor * const new_compressor = calloc (1, bytes);
+  if (new_compressor == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for compressor (%zu bytes).\n", bytes);
+
+    return NULL;
+  }
+
+  return new_compressor;
+}
+
+
+/**
+ * @brief Encodes & writes one snapshot,  with the chunks spread over a team of  `threads'.
+ */
+int
+compressor_Write_Snapshot (struct Compressor * compressor, const real_type * snapshot, size_t time_point, int threads)
+{
+  assert (compressor != NULL);
+  assert (snapshot != NULL);
+  assert (threads > 0);
+
+  const double encode_started = wallTime ();
+#ifdef WITH_OMP
+#pragma omp parallel for schedule(dynamic) num_threads (threads) if (threads > 1)
+#endif  // WITH_OMP
+  for (size_t chunk = 0; chunk < compressor->chunks_count; ++ chunk)
+  {
+    const size_t offset = chunk * compressor->chunk_points;
+    const size_t points =
+      offset + compressor->chunk_points < compressor->space_points
+        ? compressor->chunk_points
+        : compressor->space_points - offset;
+    unsigned char * const bytes = compressor->chunk_bytes + chunk * compressor->chunk_capacity;
+    const size_t length =
+      compressor->tolerance > 0.0
+        ? compressor_Encode_Lossy (
+            snapshot + offset, compressor->previous + offset, points, compressor->tolerance,
+            bytes, compressor->reconstructed + offset
+          )
+        : compressor_Encode_Lossless (
+            snapshot + offset, compressor->previous + offset, points, bytes, compressor->reconstructed + offset
+          );
+    assert (length <= compressor->chunk_capacity);
+    compressor->chunk_lengths [chunk] = (uint32_t) length;
+
+#ifndef NDEBUG
+    const int decoded = compressor_Decode_Chunk (
+      bytes, length, compressor->previous + offset, points, compressor->tolerance, compressor->decoded + offset
+    );
+    assert (decoded == 0);
+    for (size_t point = offset; point < offset + points; ++ point)
+    {
+      assert (real_ToBits (compressor->decoded [point]) == real_ToBits (compressor->reconstructed [point]));
+      assert (fabs (compressor->decoded [point] - snapshot [point]) <= compressor->tolerance);
+    }
+#endif  // NDEBUG
+  }
+
+  real_type * const previous = compressor->previous;
+  compressor->previous = compressor->reconstructed;
+  compressor->reconstructed = previous;
+
+  const double write_started = wallTime ();
+  compressor->encode_seconds += write_started - encode_started;
+
+  const uint64_t time_point_record = time_point;
+  size_t written = fwrite (& time_point_record, sizeof (time_point_record), 1, compressor->output);
+  written += fwrite (compressor->chunk_lengths, sizeof (uint32_t), compressor->chunks_count, compressor->output);
+  size_t compressed_bytes = sizeof (time_point_record) + compressor->chunks_count * sizeof (uint32_t);
+  for (size_t chunk = 0; chunk < compressor->chunks_count; ++ chunk)
+  {
+    const size_t length = compressor->chunk_lengths [chunk];
+    written += fwrite (compressor->chunk_bytes + chunk * compressor->chunk_capacity, 1, length, compressor->output)
+      == length;
+    compressed_bytes += length;
+  }
+  if (written != 1 + 2 * compressor->chunks_count)
+  {
+    fprintf (stderr, "Error: couldn't write compressed snapshot (time_point=%zu).\n", time_point);
+
+    return - 1;
+  }
+
+  compressor->write_seconds += wallTime () - write_started;
+  compressor->compressed_bytes += compressed_bytes;
+  compressor->snapshots += 1;
+
+#ifndef WITH_OMP
+  (void) threads;
+#endif  // WITH_OMP
+
+  return 0;
+}
+
+
+void *
+compressor_Writer (void * argument)
+{
+  struct Compressor * const compressor = argument;
+
+  pthread_mutex_lock (& compressor->mutex);
+  for (;;)
+  {
+    while (! compressor->pending_full && ! compressor->closing)
+    {
+      pthread_cond_wait (& compressor->condition, & compressor->mutex);
+    }
+    if (! compressor->pending_full)
+    {
+      break;
+    }
+    pthread_mutex_unlock (& compressor->mutex);
+
+    const int status = compressor_Write_Snapshot (
+      compressor, compressor->pending, compressor->pending_time_point, (int) compressor->writer_threads
+    );
+
+    pthread_mutex_lock (& compressor->mutex);
+    compressor->status = status;
+    compressor->pending_full = 0;
+    pthread_cond_broadcast (& compressor->condition);
+  }
+  pthread_mutex_unlock (& compressor->mutex);
+
+  return NULL;
+}
+
+
+/**
+ * @brief Starts the writer thread;  if that fails the compressor stays synchronous.
+ */
+void
+compressor_Start_Writer (struct Compressor * compressor)
+{
+  assert (compressor != NULL);
+  assert (! compressor->writer_started);
+
+  if (pthread_mutex_init (& compressor->mutex, NULL) != 0)
+  {
+    return;
+  }
+  if (pthread_cond_init (& compressor->condition, NULL) != 0)
+  {
+    pthread_mutex_destroy (& compressor->mutex);
+
+    return;
+  }
+#ifdef WITH_OMP
+  const int threads = omp_get_max_threads () / COMPRESSOR_WRITER_THREADS_SHARE;
+  compressor->writer_threads = threads > 1 ? (size_t) threads : 1;
+#else  // WITH_OMP
+  compressor->writer_threads = 1;
+#endif  // WITH_OMP
+  if (pthread_create (& compressor->writer, NULL, compressor_Writer, compressor) != 0)
+  {
+    pthread_cond_destroy (& compressor->condition);
+    pthread_mutex_destroy (& compressor->mutex);
+
+    return;
+  }
+
+  compressor->writer_started = 1;
+}
+
+
+/**
+ * @brief Lets the writer thread finish the pending snapshot,  if any,  and joins it.
+ */
+void
+compressor_Stop_Writer (struct Compressor * compressor)
+{
+  assert (compressor != NULL);
+
+  if (! compressor->writer_started)
+  {
+    return;
+  }
+
+  pthread_mutex_lock (& compressor->mutex);
+  compressor->closing = 1;
+  pthread_cond_broadcast (& compressor->condition);
+  pthread_mutex_unlock (& compressor->mutex);
+
+  pthread_join (compressor->writer, NULL);
+  pthread_cond_destroy (& compressor->condition);
+  pthread_mutex_destroy (& compressor->mutex);
+
+  compressor->writer_started = 0;
+}
+
+
+void
+compressor_Destroy (struct Compressor * compressor)
+{
+  if (compressor != NULL)
+  {
+    compressor_Stop_Writer (compressor);
+    if (compressor->output != NULL)
+    {
+      fclose (compressor->output);
+    }
+    free (compressor->previous);
+    free (compressor->reconstructed);
+    free (compressor->pending);
+#ifndef NDEBUG
+    free (compressor->decoded);
+#endif  // NDEBUG
+    free (compressor->chunk_bytes);
+    free (compressor->chunk_lengths);
+  }
+
+  free (compressor);
+}
+
+
+/**
+ * @brief Compressor writing to  `filename';  with a  `NULL'  one it only decodes,  see  `compressor_Read_Snapshot'.
+ */
+struct Compressor *
+compressor_Construct (const struct Parameters * parameters, const char * restrict filename)
+{
+  assert (parameters != NULL);
+  assert (parameters->compression_tolerance >= 0.0);
+
+  struct Compressor * const new_compressor = compressor_Allocate ();
+  if (new_compressor == NULL)
+  {
+    return NULL;
+  }
+
+  new_compressor->space_points = parameters->space_points;
+  new_compressor->tolerance = parameters->compression_tolerance;
+  new_compressor->chunk_points = COMPRESSOR_CHUNK_POINTS;
+  new_compressor->chunks_count = (parameters->space_points + COMPRESSOR_CHUNK_POINTS - 1) / COMPRESSOR_CHUNK_POINTS;
+  new_compressor->chunk_capacity = COMPRESSOR_CHUNK_BYTES_PER_POINT * COMPRESSOR_CHUNK_POINTS;
+
+  new_compressor->previous = calloc (parameters->space_points, sizeof (real_type));
+  new_compressor->reconstructed = calloc (parameters->space_points, sizeof (real_type));
+  new_compressor->pending = calloc (parameters->space_points, sizeof (real_type));
+#ifndef NDEBUG
+  new_compressor->decoded = calloc (parameters->space_points, sizeof (real_type));
+#endif  // NDEBUG
+  new_compressor->chunk_bytes = malloc (new_compressor->chunks_count * new_compressor->chunk_capacity);
+  new_compressor->chunk_lengths = calloc (new_compressor->chunks_count, sizeof (uint32_t));
+  if (
+       new_compressor->previous == NULL || new_compressor->reconstructed == NULL || new_compressor->pending == NULL
+#ifndef NDEBUG
+    || new_compressor->decoded == NULL
+#endif  // NDEBUG
+    || new_compressor->chunk_bytes == NULL || new_compressor->chunk_lengths == NULL
+  )
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for compressor buffers.\n");
+
+    compressor_Destroy (new_compressor);
+
+    return NULL;
+  }
+
+  if (filename == NULL)
+  {
+    return new_compressor;
+  }
+
+  new_compressor->output = fopen (filename, "wb");
+  if (new_compressor->output == NULL)
+  {
+    fprintf (stderr, "Error: couldn't open output file (%s).\n", filename);
+
+    compressor_Destroy (new_compressor);
+
+    return NULL;
+  }
+
+  fprintf (new_compressor->output, "# ");
+  parameters_Write_File (parameters, new_compressor->output);
+  fprintf (new_compressor->output, ";\n");
+  const uint64_t tolerance_bits = real_ToBits (new_compressor->tolerance);
+  if (fwrite (& tolerance_bits, sizeof (tolerance_bits), 1, new_compressor->output) != 1)
+  {
+    fprintf (stderr, "Error: couldn't write output file header (%s).\n", filename);
+
+    compressor_Destroy (new_compressor);
+
+    return NULL;
+  }
+
+  compressor_Start_Writer (new_compressor);
+
+  return new_compressor;
+}
+
+
+/**
+ * @brief Waits until the writer thread is done with the pending snapshot,  if any;  returns its result.
+ */
+int
+compressor_Wait (struct Compressor * compressor)
+{
+  assert (compressor != NULL);
+
+  if (! compressor->writer_started)
+  {
+    return compressor->status;
+  }
+
+  const double wait_started = wallTime ();
+  pthread_mutex_lock (& compressor->mutex);
+  while (compressor->pending_full)
+  {
+    pthread_cond_wait (& compressor->condition, & compressor->mutex);
+  }
+  const int status = compressor->status;
+  pthread_mutex_unlock (& compressor->mutex);
+  compressor->wait_seconds += wallTime () - wait_started;
+
+  return status;
+}
+
+
+/**
+ * @brief Takes a copy of  `snapshot'  and leaves its encoding & writing to the writer thread,  so that the caller
+ * goes on with the next time points meanwhile,  while the writer encodes the chunks in parallel on a team of its own;
+ * without a writer thread the snapshot is written right away with the chunks encoded by all threads instead.
+ * At most one snapshot is in flight:  chunks are coded against the previous one.
+ */
+int
+compressor_Submit_Snapshot (struct Compressor * compressor, const real_type * snapshot, size_t time_point)
+{
+  assert (compressor != NULL);
+  assert (snapshot != NULL);
+
+  const int waited = compressor_Wait (compressor);
+  if (waited != 0)
+  {
+    return waited;
+  }
+
+  if (compressor->writer_started)
+  {
+    memcpy (compressor->pending, snapshot, compressor->space_points * sizeof (real_type));
+
+    pthread_mutex_lock (& compressor->mutex);
+    compressor->pending_time_point = time_point;
+    compressor->pending_full = 1;
+    pthread_cond_broadcast (& compressor->condition);
+    pthread_mutex_unlock (& compressor->mutex);
+
+    return 0;
+  }
+
+#ifdef WITH_OMP
+  return compressor_Write_Snapshot (compressor, snapshot, time_point, omp_get_max_threads ());
+#else  // WITH_OMP
+  return compressor_Write_Snapshot (compressor, snapshot, time_point, 1);
+#endif  // WITH_OMP
+}
+
+
+/**
+ * @brief Parameters of a compressed solution,  from the header written by  `compressor_Construct';  the tolerance is
+ * taken from its exact bits rather than the text.
+ */
+struct Parameters *
+compressor_Read_Parameters (FILE * input)
+{
+  assert (input != NULL);
+
+  if (fgetc (input) != '#' || fgetc (input) != ' ')
+  {
+    fprintf (stderr, "Error: not a compressed solution.\n");
+
+    return NULL;
+  }
+
+  struct Parameters * const parameters = parameters_Read_File (input);
+  if (parameters == NULL)
+  {
+    return NULL;
+  }
+
+  uint64_t tolerance_bits = 0;
+  if (fgetc (input) != '\n' || fread (& tolerance_bits, sizeof (tolerance_bits), 1, input) != 1)
+  {
+    fprintf (stderr, "Error: malformed compressed solution header.\n");
+
+    parameters_Destroy (parameters);
+
+    return NULL;
+  }
+
+  parameters->compression_tolerance = real_FromBits (tolerance_bits);
+  if (! (parameters->compression_tolerance >= 0.0))
+  {
+    fprintf (stderr, "Error: malformed compressed solution tolerance.\n");
+
+    parameters_Destroy (parameters);
+
+    return NULL;
+  }
+
+  return parameters;
+}
+
+
+/**
+ * @brief Reads & decodes the next snapshot of  `input'  into  `previous',  inverse of  `compressor_Write_Snapshot';
+ * returns 1 at the end of the file.
+ */
+int
+compressor_Read_Snapshot (struct Compressor * compressor, FILE * input, size_t * time_point)
+{
+  assert (compressor != NULL);
+  assert (input != NULL);
+  assert (time_point != NULL);
+
+  uint64_t time_point_record = 0;
+  if (fread (& time_point_record, sizeof (time_point_record), 1, input) != 1)
+  {
+    if (feof (input) && ! ferror (input))
+    {
+      return 1;
+    }
+
+    fprintf (stderr, "Error: couldn't read compressed snapshot.\n");
+
+    return - 1;
+  }
+
+  const size_t lengths_read = fread (compressor->chunk_lengths, sizeof (uint32_t), compressor->chunks_count, input);
+  size_t chunks_read = 0;
+  while (lengths_read == compressor->chunks_count && chunks_read < compressor->chunks_count)
+  {
+    const size_t length = compressor->chunk_lengths [chunks_read];
+    if (
+         length > compressor->chunk_capacity
+      || fread (compressor->chunk_bytes + chunks_read * compressor->chunk_capacity, 1, length, input) != length
+    )
+    {
+      break;
+    }
+    ++ chunks_read;
+  }
+  if (chunks_read != compressor->chunks_count)
+  {
+    fprintf (stderr, "Error: couldn't read compressed snapshot (time_point=%zu).\n", (size_t) time_point_record);
+
+    return - 1;
+  }
+
+  size_t corrupted = 0;
+#ifdef WITH_OMP
+#pragma omp parallel for schedule(dynamic) reduction(+ : corrupted)
+#endif  // WITH_OMP
+  for (size_t chunk = 0; chunk < compressor->chunks_count; ++ chunk)
+  {
+    const size_t offset = chunk * compressor->chunk_points;
+    const size_t points =
+      offset + compressor->chunk_points < compressor->space_points
+        ? compressor->chunk_points
+        : compressor->space_points - offset;
+    const int decoded = compressor_Decode_Chunk (
+      compressor->chunk_bytes + chunk * compressor->chunk_capacity, compressor->chunk_lengths [chunk],
+      compressor->previous + offset, points, compressor->tolerance, compressor->reconstructed + offset
+    );
+    corrupted += decoded != 0;
+  }
+  if (corrupted != 0)
+  {
+    fprintf (stderr, "Error: corrupted compressed snapshot (time_point=%zu).\n", (size_t) time_point_record);
+
+    return - 1;
+  }
+
+  real_type * const previous = compressor->previous;
+  compressor->previous = compressor->reconstructed;
+  compressor->reconstructed = previous;
+
+  * time_point = time_point_record;
+
+  return 0;
+}
+
+
+int
+compressor_Write_Statistics (const struct Compressor * compressor, FILE * output)
+{
+  assert (compressor != NULL);
+  assert (output != NULL);
+
+  const size_t raw_bytes = compressor->snapshots * compressor->space_points * sizeof (real_type);
+  const double ratio =
+    compressor->compressed_bytes == 0 ? 0.0 : (double) raw_bytes / (double) compressor->compressed_bytes;
+  const double throughput =
+    compressor->encode_seconds > 0.0 ? (double) raw_bytes / compressor->encode_seconds / 1.0e6 : 0.0;
+
+  return fprintf (
+    output,
+    "Compression{tolerance=%g;snapshots=%zu;raw_bytes=%zu;compressed_bytes=%zu;ratio=%.3f;encode_seconds=%.6f;encode_mb_per_second=%.1f;write_seconds=%.6f;wait_seconds=%.6f;}",
+    compressor->tolerance, compressor->snapshots, raw_bytes, compressor->compressed_bytes, ratio,
+    compressor->encode_seconds, throughput, compressor->write_seconds, compressor->wait_seconds
+  );
+}
+
+
+#define COMPRESSED_SOLUTION_FILENAME ("solution.hcz")
+
+
+static struct Compressor * solution_compressor = NULL;
+
+
+int
+openCompressedSolution_File (const struct Parameters * parameters, const struct Mesh * mesh_, size_t time_point_)
+{
+  (void) mesh_;
+  (void) time_point_;
+
+  compressor_Destroy (solution_compressor);
+  solution_compressor = compressor_Construct (parameters, COMPRESSED_SOLUTION_FILENAME);
+  if (solution_compressor == NULL)
+  {
+    fprintf (stderr, "Error: couldn't construct compressor.\n");
+
+    return - 1;
+  }
+
+  return 0;
+}
+
+
+int
+writeCompressedSolution_File (const struct Parameters * parameters_, const struct Mesh * mesh, size_t time_point)
+{
+  (void) parameters_;
+
+  if (time_point % WRITE_EVERY_NTH_SOLUTION != 0)
+  {
+    return 0;
+  }
+
+  assert (solution_compressor != NULL);
+
+  return compressor_Submit_Snapshot (
+    solution_compressor, & mesh->points [mesh_PointIndex (mesh, time_point, 0)], time_point
+  );
+}
+
+
+int
+closeCompressedSolution_File (const struct Parameters * parameters_, const struct Mesh * mesh_, size_t time_point_)
+{
+  (void) parameters_;
+  (void) mesh_;
+  (void) time_point_;
+
+  assert (solution_compressor != NULL);
+
+  const int waited = compressor_Wait (solution_compressor);
+  if (waited != 0)
+  {
+    fprintf (stderr, "Error: couldn't write output file (%s).\n", COMPRESSED_SOLUTION_FILENAME);
+
+    compressor_Destroy (solution_compressor);
+    solution_compressor = NULL;
+
+    return waited;
+  }
+
+  compressor_Write_Statistics (solution_compressor, stdout);
+  fprintf (stdout, ";\n");
+
+  const int flushed = fflush (solution_compressor->output);
+  if (flushed != 0)
+  {
+    fprintf (stderr, "Error: couldn't flush output file (%s).\n", COMPRESSED_SOLUTION_FILENAME);
+
+    compressor_Destroy (solution_compressor);
+    solution_compressor = NULL;
+
+    return flushed;
+  }
+
+  const int closed = fclose (solution_compressor->output);
+  solution_compressor->output = NULL;
+  compressor_Destroy (solution_compressor);
+  solution_compressor = NULL;
+  if (closed != 0)
+  {
+    fprintf (stderr, "Error: couldn't close output file (%s).\n", COMPRESSED_SOLUTION_FILENAME);
 
     return closed;
   }
@@ -680,7 +3420,68 @@ writeSolution_File (const struct Parameters * parameters, const struct Mesh * me
 }
 
 
-#define PI (3.141592653589793238462643383279502884)
+#define ANALYTICS_FILENAME ("analytics.dat")
+
+
+static FILE * analytics_output = NULL;
+
+
+/**
+ * @brief Streams one line per time point;  the file is opened at the first and closed at the last time point.
+ * Values are written with the 17 significant digits that round-trip a  `double'.
+ */
+int
+writeAnalytics_File (const struct Parameters * parameters, const struct Analytics * analytics, size_t time_point)
+{
+  if (time_point == 0)
+  {
+    analytics_output = fopen (ANALYTICS_FILENAME, "w");
+    if (analytics_output == NULL)
+    {
+      fprintf (stderr, "Error: couldn't open output file (%s).\n", ANALYTICS_FILENAME);
+
+      return - 1;
+    }
+
+    fprintf (analytics_output, "# ");
+    parameters_Write_File (parameters, analytics_output);
+    fprintf (analytics_output, ";\n");
+    fprintf (
+      analytics_output,
+      "time_point time temperature_min temperature_max energy heat_flux_0 heat_flux_1 error_l2\n"
+    );
+  }
+
+  assert (analytics_output != NULL);
+
+  fprintf (
+    analytics_output, "%zu %.17g %.17g %.17g %.17g %.17g %.17g %.17g\n",
+    time_point, analytics->time, analytics->temperature_min, analytics->temperature_max, analytics->energy,
+    analytics->heat_flux_0, analytics->heat_flux_1, analytics->error_l2
+  );
+
+  if (time_point == parameters->time_points - 1)
+  {
+    const int flushed = fflush (analytics_output);
+    if (flushed != 0)
+    {
+      fprintf (stderr, "Error: couldn't flush output file (%s).\n", ANALYTICS_FILENAME);
+
+      return flushed;
+    }
+
+    const int closed = fclose (analytics_output);
+    analytics_output = NULL;
+    if (closed != 0)
+    {
+      fprintf (stderr, "Error: couldn't close output file (%s).\n", ANALYTICS_FILENAME);
+
+      return closed;
+    }
+  }
+
+  return 0;
+}
 
 
 real_type
@@ -694,11 +3495,16 @@ initialCondition (real_type space)
 #define INPUT_STDIN (INPUT_DEFAULT + 1)
 
 
+#define OUTPUT_DAT (1)
+#define OUTPUT_COMPRESSED (OUTPUT_DAT + 1)
+#define OUTPUT_NONE (OUTPUT_COMPRESSED + 1)
+
+
 int
 run (void)
 {
 #if INPUT == INPUT_DEFAULT
-  struct Parameters * const parameters = parameters_Construct (1.0, initialCondition, 1.0, - 1.0, 5.0, 5.0 * PI, 1000 + 1, 100);
+  struct Parameters * const parameters = parameters_Construct (1.0, initialCondition, 1.0, - 1.0, 5.0, 5.0 * PI, 1000 + 1, 100, 0.0, 0.0, 0, 0.0);
   if (parameters == NULL)
   {
     fprintf (stderr, "Error: couldn't allocate memory for parameters, exiting.\n");
@@ -729,14 +3535,41 @@ run (void)
   );
 #endif //  WITH_OMP
 
+#if OUTPUT == OUTPUT_DAT
   solution_visitor_type * const before_solution = writeGnuplotScript_File;
 //  solution_visitor_type * const on_solution = writeSolution_Stdout;
   solution_visitor_type * const on_solution = writeSolution_File;
-  const int solved = solve (parameters, before_solution, on_solution);
+  solution_visitor_type * const after_solution = NULL;
+#elif OUTPUT == OUTPUT_COMPRESSED
+  solution_visitor_type * const before_solution = openCompressedSolution_File;
+  solution_visitor_type * const on_solution = writeCompressedSolution_File;
+  solution_visitor_type * const after_solution = closeCompressedSolution_File;
+#elif OUTPUT == OUTPUT_NONE
+  solution_visitor_type * const before_solution = NULL;
+  solution_visitor_type * const on_solution = NULL;
+  solution_visitor_type * const after_solution = NULL;
+#else  // OUTPUT == OUTPUT_NONE
+#error "Unsupported output."
+#endif  // OUTPUT == OUTPUT_DAT
+#ifdef WITH_ANALYTICS
+  analytics_visitor_type * const on_analytics = writeAnalytics_File;
+#else  // WITH_ANALYTICS
+  analytics_visitor_type * const on_analytics = NULL;
+#endif  // WITH_ANALYTICS
+  refinement_visitor_type * const after_refinement = writeRefinementStatistics_Stdout;
+  const int solved = solve (parameters, before_solution, on_solution, after_solution, on_analytics, after_refinement);
   if (solved != 0)
   {
     fprintf (stderr, "Error: couldn't solve, exiting.\n");
 
+#if OUTPUT == OUTPUT_COMPRESSED
+    /*
+     * `solve'  may have failed between  `openCompressedSolution_File'  &  `closeCompressedSolution_File',  so the
+     * writer thread may still be running.
+     */
+    compressor_Destroy (solution_compressor);
+    solution_compressor = NULL;
+#endif  // OUTPUT == OUTPUT_COMPRESSED
     parameters_Destroy (parameters);
 
     return EXIT_FAILURE;
@@ -748,12 +3581,74 @@ run (void)
 }
 
 
+/**
+ * @brief Expands a compressed solution  (see  `OUTPUT_COMPRESSED')  into the  `N.dat'  files & gnuplot script
+ * `OUTPUT_DAT'  would have written.
+ */
+int
+expand (const char * restrict filename)
+{
+  FILE * const input = fopen (filename, "rb");
+  if (input == NULL)
+  {
+    fprintf (stderr, "Error: couldn't open input file (%s), exiting.\n", filename);
+
+    return EXIT_FAILURE;
+  }
+
+  struct Parameters * const parameters = compressor_Read_Parameters (input);
+  if (parameters == NULL)
+  {
+    fprintf (stderr, "Error: couldn't read parameters (%s), exiting.\n", filename);
+
+    fclose (input);
+
+    return EXIT_FAILURE;
+  }
+
+  parameters_Write_File (parameters, stdout);
+  fprintf (stdout, ";\n");
+
+  struct Compressor * const decompressor = compressor_Construct (parameters, NULL);
+  struct Mesh * const mesh = mesh_Construct (2, parameters->space_points);
+  int failed = decompressor == NULL || mesh == NULL || writeGnuplotScript_File (parameters, mesh, 0) != 0;
+  size_t time_point = 0;
+  int read = 0;
+  while (! failed && (read = compressor_Read_Snapshot (decompressor, input, & time_point)) == 0)
+  {
+    memcpy (
+      & mesh->points [mesh_PointIndex (mesh, time_point, 0)], decompressor->previous,
+      parameters->space_points * sizeof (real_type)
+    );
+    failed = writeSolution_File (parameters, mesh, time_point) != 0;
+  }
+  failed |= read < 0;
+  if (failed)
+  {
+    fprintf (stderr, "Error: couldn't expand compressed solution (%s), exiting.\n", filename);
+  }
+
+  mesh_Destroy (mesh);
+  compressor_Destroy (decompressor);
+  parameters_Destroy (parameters);
+  fclose (input);
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/*
+ * `WITHOUT_MAIN'  lets the regression tests include this file and drive  `solve'  directly.
+ * `main FILE'  expands the compressed solution  `FILE'  instead of solving.
+ */
+#ifndef WITHOUT_MAIN
 int
 main (int argc, char * argv [])
 {
-  const int done = run ();
+  const int done = argc > 1 ? expand (argv [1]) : run ();
 
   printf ("Done.\n");
 
   return done;
 }
+#endif  // WITHOUT_MAIN
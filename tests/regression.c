@@ -0,0 +1,969 @@
+/*
+ * Regression suite driven by CTest:  a debug & an optimized executable per  `METHOD',  one test per command line
+ *   convergence-space
+ *   convergence-graded
+ *   convergence-time
+ *   determinism
+ *   refinement
+ *   steady-state
+ *   heat-flux
+ *   compression
+ *   throughput <scalar|flux|graded|refined> <budget>
+ * Each test prints its measurements as a  `Name{...};'  line and fails with a nonzero exit code.
+ */
+#include "main.c"
+
+
+#define TEST_SPACE_MAX (5.0 * PI)
+#define TEST_BOUNDARY_CONDITION_0 (1.0)
+#define TEST_BOUNDARY_CONDITION_1 (- 1.0)
+
+
+static real_type * captured_row = NULL;
+static size_t captured_points = 0;
+
+
+/**
+ * @brief  `after_solution'  visitor keeping a copy of the last row.
+ */
+static int
+captureSolution (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point)
+{
+  (void) parameters;
+  assert (parameters != NULL);
+  assert (mesh != NULL);
+
+  free (captured_row);
+  captured_points = mesh->space_points;
+  captured_row = malloc (captured_points * sizeof (real_type));
+  if (captured_row == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for captured row (%zu points).\n", captured_points);
+
+    return - 1;
+  }
+
+  memcpy (captured_row, & mesh->points [mesh_PointIndex (mesh, time_point, 0)], captured_points * sizeof (real_type));
+
+  return 0;
+}
+
+
+static struct Parameters *
+test_Parameters (real_type time_max, size_t time_points, size_t space_points)
+{
+  return parameters_Construct (
+    1.0, initialCondition, TEST_BOUNDARY_CONDITION_0, TEST_BOUNDARY_CONDITION_1, time_max, TEST_SPACE_MAX,
+    time_points, space_points, 0.0, 0.0, 0, 0.0
+  );
+}
+
+
+/**
+ * @brief Runs  `solve'  and leaves the last row in  `captured_row'.
+ */
+static int
+test_Solve (const struct Parameters * parameters)
+{
+  const int solved = solve (parameters, NULL, NULL, captureSolution, NULL, NULL);
+  if (solved != 0)
+  {
+    fprintf (stderr, "Error: couldn't solve.\n");
+  }
+
+  return solved;
+}
+
+
+/**
+ * @brief Discrete L2 norm  (trapezoidal)  of  `captured_row'  minus  `reference'  on the grid of  `parameters'.
+ */
+static real_type
+test_Error (const struct Parameters * parameters, const real_type * reference)
+{
+  real_type sum = 0.0;
+  for (size_t space_point = 1; space_point + 1 < captured_points; ++ space_point)
+  {
+    const real_type error = captured_row [space_point] - reference [space_point];
+    const real_type width =
+      0.5 * (parameters_Space (parameters, space_point + 1) - parameters_Space (parameters, space_point - 1));
+    sum += width * error * error;
+  }
+
+  return sqrt (sum);
+}
+
+
+#define CONVERGENCE_RUNS (3)
+#define CONVERGENCE_SPACE_INTERVALS (40)
+#define CONVERGENCE_SPACE_TIME_STEPS (100)
+#define CONVERGENCE_SPACE_R (0.2)
+#define CONVERGENCE_SPACE_ORDER (2.0)
+#define CONVERGENCE_TIME_INTERVALS (40)
+#define CONVERGENCE_TIME_MAX (2.0)
+#define CONVERGENCE_TIME_STEPS (32)
+#define CONVERGENCE_ORDER_TOLERANCE (0.2)
+
+
+#define CONVERGENCE_GRID_GRADING (0.5)
+
+
+/**
+ * @brief Spatial order against the sine-series solution of the PDE:  Δx  halves and  Δt  quarters,  r = αΔt/Δx²
+ * stays fixed,  so both methods must show the 2nd order of the central difference.  A smooth grading keeps it.
+ */
+static int
+test_Convergence_Space (real_type grid_grading)
+{
+  const real_type space_step_0 = TEST_SPACE_MAX / CONVERGENCE_SPACE_INTERVALS;
+  const real_type time_max = CONVERGENCE_SPACE_TIME_STEPS * CONVERGENCE_SPACE_R * space_step_0 * space_step_0;
+  real_type errors [CONVERGENCE_RUNS];
+  for (size_t run = 0; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const size_t intervals = CONVERGENCE_SPACE_INTERVALS << run;
+    const size_t time_steps = CONVERGENCE_SPACE_TIME_STEPS << (2 * run);
+    struct Parameters * const parameters = test_Parameters (time_max, time_steps + 1, intervals + 1);
+    if (parameters != NULL)
+    {
+      parameters->grid_grading = grid_grading;
+    }
+    struct AnalyticSolution * const analytic_solution = analyticSolution_Construct (parameters);
+    real_type * const reference = malloc ((intervals + 1) * sizeof (real_type));
+    if (parameters == NULL || analytic_solution == NULL || reference == NULL || test_Solve (parameters) != 0)
+    {
+      fprintf (stderr, "Error: couldn't run convergence case (%zu intervals).\n", intervals);
+
+      free (reference);
+      analyticSolution_Destroy (analytic_solution);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    analyticSolution_Advance (analytic_solution, time_max);
+    for (size_t space_point = 0; space_point <= intervals; ++ space_point)
+    {
+      reference [space_point] = analyticSolution_Evaluate (analytic_solution, parameters_Space (parameters, space_point));
+    }
+    errors [run] = test_Error (parameters, reference);
+
+    free (reference);
+    analyticSolution_Destroy (analytic_solution);
+    parameters_Destroy (parameters);
+  }
+
+  int failed = 0;
+  for (size_t run = 1; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const real_type order = log2 (errors [run - 1] / errors [run]);
+    printf (
+      "ConvergenceSpace{method=%d;grid_grading=%.2f;intervals=%d;error=%.6e;order=%.3f;expected=%.1f;};\n",
+      METHOD, grid_grading, CONVERGENCE_SPACE_INTERVALS << run, errors [run], order, CONVERGENCE_SPACE_ORDER
+    );
+    failed |= ! (order >= CONVERGENCE_SPACE_ORDER - CONVERGENCE_ORDER_TOLERANCE);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/**
+ * @brief Exact solution of the semi-discrete system  u' = α D₂ u  at  `time',  by the discrete sine series of the
+ * initial deviation from the linear steady state.
+ */
+static void
+test_SemiDiscrete (const struct Parameters * parameters, real_type time, real_type * solution)
+{
+  const size_t intervals = parameters->space_points - 1;
+  const real_type space_step = parameters->space_max / (real_type) intervals;
+  for (size_t space_point = 0; space_point <= intervals; ++ space_point)
+  {
+    solution [space_point] = lerp (
+      (real_type) space_point, 0.0, (real_type) intervals,
+      parameters->boundary_condition_0, parameters->boundary_condition_1
+    );
+  }
+
+  for (size_t mode = 1; mode < intervals; ++ mode)
+  {
+    real_type coefficient = 0.0;
+    for (size_t space_point = 1; space_point < intervals; ++ space_point)
+    {
+      const real_type steady = lerp (
+        (real_type) space_point, 0.0, (real_type) intervals,
+        parameters->boundary_condition_0, parameters->boundary_condition_1
+      );
+      coefficient +=
+          (parameters->initial_condition (parameters_Space (parameters, space_point)) - steady)
+        * sin (PI * (real_type) (mode * space_point) / (real_type) intervals);
+    }
+    coefficient *= 2.0 / (real_type) intervals;
+
+    const real_type eigenvalue =
+      4.0 * parameters->diffusivity / (space_step * space_step)
+        * pow (sin (PI * (real_type) mode / (2.0 * (real_type) intervals)), 2.0);
+    const real_type amplitude = coefficient * exp (- eigenvalue * time);
+    for (size_t space_point = 1; space_point < intervals; ++ space_point)
+    {
+      solution [space_point] += amplitude * sin (PI * (real_type) (mode * space_point) / (real_type) intervals);
+    }
+  }
+}
+
+
+/**
+ * @brief Temporal order on a fixed grid against the exact semi-discrete solution,  which removes the spatial error:
+ * 1 for Euler,  4 for RK4.
+ */
+static int
+test_Convergence_Time (void)
+{
+#if METHOD == METHOD_EULER
+  const real_type expected = 1.0;
+#elif METHOD == METHOD_RK4
+  const real_type expected = 4.0;
+#endif  // METHOD == METHOD_EULER
+  real_type * const reference = malloc ((CONVERGENCE_TIME_INTERVALS + 1) * sizeof (real_type));
+  struct Parameters * const reference_parameters =
+    test_Parameters (CONVERGENCE_TIME_MAX, CONVERGENCE_TIME_STEPS + 1, CONVERGENCE_TIME_INTERVALS + 1);
+  if (reference == NULL || reference_parameters == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for reference solution.\n");
+
+    parameters_Destroy (reference_parameters);
+    free (reference);
+
+    return EXIT_FAILURE;
+  }
+
+  test_SemiDiscrete (reference_parameters, CONVERGENCE_TIME_MAX, reference);
+  parameters_Destroy (reference_parameters);
+
+  real_type errors [CONVERGENCE_RUNS];
+  for (size_t run = 0; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const size_t time_steps = (size_t) CONVERGENCE_TIME_STEPS << run;
+    struct Parameters * const parameters =
+      test_Parameters (CONVERGENCE_TIME_MAX, time_steps + 1, CONVERGENCE_TIME_INTERVALS + 1);
+    if (parameters == NULL || test_Solve (parameters) != 0)
+    {
+      fprintf (stderr, "Error: couldn't run convergence case (%zu steps).\n", time_steps);
+
+      parameters_Destroy (parameters);
+      free (reference);
+
+      return EXIT_FAILURE;
+    }
+
+    errors [run] = test_Error (parameters, reference);
+    parameters_Destroy (parameters);
+  }
+  free (reference);
+
+  int failed = 0;
+  for (size_t run = 1; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const real_type order = log2 (errors [run - 1] / errors [run]);
+    printf (
+      "ConvergenceTime{method=%d;time_steps=%d;error=%.6e;order=%.3f;expected=%.1f;};\n",
+      METHOD, CONVERGENCE_TIME_STEPS << run, errors [run], order, expected
+    );
+    failed |= ! (order >= expected - CONVERGENCE_ORDER_TOLERANCE);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+#define DETERMINISM_SPACE_POINTS (2001)
+#define DETERMINISM_TIME_POINTS (401)
+#define DETERMINISM_TIME_MAX (5.0e-3)
+#define DETERMINISM_THREADS_MAX (4)
+
+
+static real_type
+test_Diffusivity (real_type space)
+{
+  return 1.0 + 0.5 * sin (space);
+}
+
+
+static real_type
+test_Source (real_type space)
+{
+  return cos (space);
+}
+
+
+/**
+ * @brief Bitwise equal rows for every kernel from 1 to  `DETERMINISM_THREADS_MAX'  threads:  each point is written by
+ * exactly one thread and only the analytics reductions depend on the thread count.
+ */
+static int
+test_Determinism (void)
+{
+#ifdef WITH_OMP
+  static const char * const kernels [] = { "scalar", "flux", "graded", "refined" };
+  int failed = 0;
+  for (size_t kernel = 0; kernel < sizeof (kernels) / sizeof (kernels [0]); ++ kernel)
+  {
+    struct Parameters * const parameters =
+      test_Parameters (DETERMINISM_TIME_MAX, DETERMINISM_TIME_POINTS, DETERMINISM_SPACE_POINTS);
+    if (parameters == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for parameters.\n");
+
+      return EXIT_FAILURE;
+    }
+
+    if (kernel == 1)
+    {
+      parameters->diffusivity_profile = test_Diffusivity;
+      parameters->source_profile = test_Source;
+    }
+    else if (kernel == 2)
+    {
+      parameters->grid_grading = 0.5;
+    }
+    else if (kernel == 3)
+    {
+      parameters->refinement_levels = 2;
+      parameters->refinement_threshold = 5.0e-3;
+    }
+
+    real_type * reference = NULL;
+    for (int threads = 1; threads <= DETERMINISM_THREADS_MAX; ++ threads)
+    {
+      omp_set_num_threads (threads);
+      if (test_Solve (parameters) != 0)
+      {
+        free (reference);
+        parameters_Destroy (parameters);
+
+        return EXIT_FAILURE;
+      }
+
+      if (reference == NULL)
+      {
+        reference = captured_row;
+        captured_row = NULL;
+
+        continue;
+      }
+
+      const int equal = memcmp (reference, captured_row, captured_points * sizeof (real_type)) == 0;
+      printf ("Determinism{method=%d;kernel=%s;threads=%d;equal=%d;};\n", METHOD, kernels [kernel], threads, equal);
+      failed |= ! equal;
+    }
+
+    free (reference);
+    parameters_Destroy (parameters);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+#else  // WITH_OMP
+  printf ("Determinism{method=%d;skipped=1;};\n", METHOD);
+
+  return EXIT_SUCCESS;
+#endif  // WITH_OMP
+}
+
+
+#define REFINEMENT_TOLERANCE (1.0e-12)
+
+
+/**
+ * @brief One level refined everywhere  (threshold 0)  against the uniform grid it refines to:  after injection the
+ * base points must carry the same error,  up to rounding since the patches bisect the base positions and take the
+ * flux-form kernel.  The base grid alone must be less accurate,  or the comparison proves nothing.
+ */
+static int
+test_Refinement (void)
+{
+  const real_type space_step = TEST_SPACE_MAX / CONVERGENCE_SPACE_INTERVALS;
+  const real_type time_max = CONVERGENCE_SPACE_TIME_STEPS * CONVERGENCE_SPACE_R * space_step * space_step;
+  struct Parameters * const parameters =
+    test_Parameters (time_max, CONVERGENCE_SPACE_TIME_STEPS + 1, CONVERGENCE_SPACE_INTERVALS + 1);
+  struct Parameters * const uniform_parameters = test_Parameters (
+    time_max, REFINEMENT_SUBSTEPS * CONVERGENCE_SPACE_TIME_STEPS + 1, 2 * CONVERGENCE_SPACE_INTERVALS + 1
+  );
+  struct AnalyticSolution * const analytic_solution =
+    parameters == NULL ? NULL : analyticSolution_Construct (parameters);
+  real_type * const reference = malloc ((CONVERGENCE_SPACE_INTERVALS + 1) * sizeof (real_type));
+  if (parameters == NULL || uniform_parameters == NULL || analytic_solution == NULL || reference == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for refinement case.\n");
+
+    free (reference);
+    analyticSolution_Destroy (analytic_solution);
+    parameters_Destroy (uniform_parameters);
+    parameters_Destroy (parameters);
+
+    return EXIT_FAILURE;
+  }
+
+  analyticSolution_Advance (analytic_solution, time_max);
+  for (size_t space_point = 0; space_point <= CONVERGENCE_SPACE_INTERVALS; ++ space_point)
+  {
+    reference [space_point] = analyticSolution_Evaluate (analytic_solution, parameters_Space (parameters, space_point));
+  }
+  analyticSolution_Destroy (analytic_solution);
+
+  /*
+   * The base grid alone,  refined and the uniform grid,  whose row is reduced to the base points.
+   */
+  real_type errors [3];
+  for (size_t run = 0; run < 3; ++ run)
+  {
+    parameters->refinement_levels = run == 1 ? 1 : 0;
+    if (test_Solve (run == 2 ? uniform_parameters : parameters) != 0)
+    {
+      free (reference);
+      parameters_Destroy (uniform_parameters);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    if (run == 2)
+    {
+      for (size_t space_point = 0; space_point <= CONVERGENCE_SPACE_INTERVALS; ++ space_point)
+      {
+        captured_row [space_point] = captured_row [2 * space_point];
+      }
+      captured_points = CONVERGENCE_SPACE_INTERVALS + 1;
+    }
+    errors [run] = test_Error (parameters, reference);
+  }
+  free (reference);
+  parameters_Destroy (uniform_parameters);
+  parameters_Destroy (parameters);
+
+  printf (
+    "Refinement{method=%d;intervals=%d;error_base=%.6e;error_refined=%.17g;error_uniform=%.17g;};\n",
+    METHOD, CONVERGENCE_SPACE_INTERVALS, errors [0], errors [1], errors [2]
+  );
+
+  return
+       fabs (errors [1] - errors [2]) <= REFINEMENT_TOLERANCE * errors [2]
+    && errors [1] < errors [0]
+      ? EXIT_SUCCESS
+      : EXIT_FAILURE;
+}
+
+
+#define HEAT_FLUX_TIME_POINTS (11)
+#define HEAT_FLUX_TIME_MAX (1.0)
+#define HEAT_FLUX_TOLERANCE (1.0e-12)
+
+
+static struct Analytics captured_analytics;
+
+
+/**
+ * @brief  `on_analytics'  visitor keeping the last analytics.
+ */
+static int
+captureAnalytics (const struct Parameters * parameters, const struct Analytics * analytics, size_t time_point)
+{
+  (void) parameters;
+  (void) time_point;
+
+  captured_analytics = * analytics;
+
+  return 0;
+}
+
+
+/**
+ * @brief The linear steady state between the boundary conditions.
+ */
+static real_type
+test_Linear (real_type space)
+{
+  return TEST_BOUNDARY_CONDITION_0 + (TEST_BOUNDARY_CONDITION_1 - TEST_BOUNDARY_CONDITION_0) * space / TEST_SPACE_MAX;
+}
+
+
+/**
+ * @brief Both boundary fluxes are  -α∂u/∂x  of the linear steady state,  whether the grid is too small for the
+ * one-sided stencil  (two points)  or not.
+ */
+static int
+test_Heat_Flux (void)
+{
+  static const size_t space_points [] = { 2, 3, 4 };
+  const real_type expected = - (TEST_BOUNDARY_CONDITION_1 - TEST_BOUNDARY_CONDITION_0) / TEST_SPACE_MAX;
+  int failed = 0;
+  for (size_t grid = 0; grid < sizeof (space_points) / sizeof (space_points [0]); ++ grid)
+  {
+    struct Parameters * const parameters =
+      test_Parameters (HEAT_FLUX_TIME_MAX, HEAT_FLUX_TIME_POINTS, space_points [grid]);
+    if (parameters == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for parameters.\n");
+
+      return EXIT_FAILURE;
+    }
+
+    parameters->initial_condition = test_Linear;
+    const int solved = solve (parameters, NULL, NULL, NULL, captureAnalytics, NULL);
+    parameters_Destroy (parameters);
+    if (solved != 0)
+    {
+      fprintf (stderr, "Error: couldn't solve.\n");
+
+      return EXIT_FAILURE;
+    }
+
+    const real_type heat_flux_0 = captured_analytics.heat_flux_0;
+    const real_type heat_flux_1 = captured_analytics.heat_flux_1;
+    printf (
+      "HeatFlux{method=%d;space_points=%zu;heat_flux_0=%.17g;heat_flux_1=%.17g;expected=%.17g;};\n",
+      METHOD, space_points [grid], heat_flux_0, heat_flux_1, expected
+    );
+    failed |= ! (fabs (heat_flux_0 - expected) <= HEAT_FLUX_TOLERANCE * expected);
+    failed |= ! (fabs (heat_flux_1 - expected) <= HEAT_FLUX_TOLERANCE * expected);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+#define STEADY_STATE_TIME_MAX (1000.0)
+#define STEADY_STATE_TIME_STEPS (10000)
+#define STEADY_STATE_INTERVALS (20)
+#define STEADY_STATE_QUADRATURE_INTERVALS (64)
+#define STEADY_STATE_ORDER (2.0)
+
+
+/**
+ * @brief ∫dx/α  over  [a, b]  by Simpson's rule.
+ */
+static real_type
+test_Resistance (real_type a, real_type b)
+{
+  const real_type step = (b - a) / STEADY_STATE_QUADRATURE_INTERVALS;
+  real_type sum = 1.0 / test_Diffusivity (a) + 1.0 / test_Diffusivity (b);
+  for (size_t interval = 1; interval < STEADY_STATE_QUADRATURE_INTERVALS; ++ interval)
+  {
+    sum += (interval % 2 == 1 ? 4.0 : 2.0) / test_Diffusivity (a + (real_type) interval * step);
+  }
+
+  return sum * step / 3.0;
+}
+
+
+/**
+ * @brief Spatial order of the flux-form kernel with α(x)  against its steady state:  the flux  -α∂u/∂x  is
+ * constant,  so  u(x) - β₀  is proportional to  ∫₀ˣdξ/α.  Δx  halves and  Δt  quarters,  and  `time_max'  is many
+ * times the slowest decay time,  so only the spatial error is left.
+ */
+static int
+test_Steady_State (void)
+{
+  real_type errors [CONVERGENCE_RUNS];
+  for (size_t run = 0; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const size_t intervals = STEADY_STATE_INTERVALS << run;
+    const size_t time_steps = (size_t) STEADY_STATE_TIME_STEPS << (2 * run);
+    struct Parameters * const parameters = test_Parameters (STEADY_STATE_TIME_MAX, time_steps + 1, intervals + 1);
+    real_type * const reference = malloc ((intervals + 1) * sizeof (real_type));
+    if (parameters == NULL || reference == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for steady state case (%zu intervals).\n", intervals);
+
+      free (reference);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    parameters->diffusivity_profile = test_Diffusivity;
+    parameters->initial_condition = test_Linear;
+    if (test_Solve (parameters) != 0)
+    {
+      free (reference);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    reference [0] = 0.0;
+    for (size_t space_point = 1; space_point <= intervals; ++ space_point)
+    {
+      reference [space_point] = reference [space_point - 1] + test_Resistance (
+        parameters_Space (parameters, space_point - 1), parameters_Space (parameters, space_point)
+      );
+    }
+    const real_type resistance = reference [intervals];
+    for (size_t space_point = 0; space_point <= intervals; ++ space_point)
+    {
+      reference [space_point] = TEST_BOUNDARY_CONDITION_0
+        + (TEST_BOUNDARY_CONDITION_1 - TEST_BOUNDARY_CONDITION_0) * reference [space_point] / resistance;
+    }
+    errors [run] = test_Error (parameters, reference);
+
+    free (reference);
+    parameters_Destroy (parameters);
+  }
+
+  int failed = 0;
+  for (size_t run = 1; run < CONVERGENCE_RUNS; ++ run)
+  {
+    const real_type order = log2 (errors [run - 1] / errors [run]);
+    printf (
+      "SteadyState{method=%d;intervals=%d;error=%.6e;order=%.3f;expected=%.1f;};\n",
+      METHOD, STEADY_STATE_INTERVALS << run, errors [run], order, STEADY_STATE_ORDER
+    );
+    failed |= ! (order >= STEADY_STATE_ORDER - CONVERGENCE_ORDER_TOLERANCE);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+#define COMPRESSION_SPACE_POINTS (5001)
+#define COMPRESSION_TIME_POINTS (201)
+#define COMPRESSION_TIME_MAX (5.0e-4)
+#define COMPRESSION_GARBAGE_BYTES (64)
+#define COMPRESSION_GARBAGE_POINTS (16)
+
+
+static real_type * written_rows = NULL;
+
+
+/**
+ * @brief  `on_solution'  visitor of  `OUTPUT_COMPRESSED'  also keeping a copy of every row it writes.
+ */
+static int
+test_Compress_Solution (const struct Parameters * parameters, const struct Mesh * mesh, size_t time_point)
+{
+  if (time_point % WRITE_EVERY_NTH_SOLUTION == 0)
+  {
+    memcpy (
+      written_rows + time_point / WRITE_EVERY_NTH_SOLUTION * mesh->space_points,
+      & mesh->points [mesh_PointIndex (mesh, time_point, 0)], mesh->space_points * sizeof (real_type)
+    );
+  }
+
+  return writeCompressedSolution_File (parameters, mesh, time_point);
+}
+
+
+/**
+ * @brief Round trip of  `solution.hcz'  through  `compressor_Read_Snapshot':  bitwise equal rows when lossless,
+ * within the tolerance otherwise.  The tolerances include ones the text header can't hold exactly.  Corrupted chunks
+ * must be rejected.
+ */
+static int
+test_Compression (void)
+{
+  static const real_type tolerances [] = { 0.0, 1.0e-6, 1.234567891234e-13, 1.0e-22 };
+  const size_t rows = (COMPRESSION_TIME_POINTS - 1) / WRITE_EVERY_NTH_SOLUTION + 1;
+  int failed = 0;
+  for (size_t tolerance = 0; tolerance < sizeof (tolerances) / sizeof (tolerances [0]); ++ tolerance)
+  {
+    struct Parameters * const parameters =
+      test_Parameters (COMPRESSION_TIME_MAX, COMPRESSION_TIME_POINTS, COMPRESSION_SPACE_POINTS);
+    written_rows = malloc (rows * COMPRESSION_SPACE_POINTS * sizeof (real_type));
+    if (parameters == NULL || written_rows == NULL)
+    {
+      fprintf (stderr, "Error: couldn't allocate memory for compression case.\n");
+
+      free (written_rows);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    parameters->compression_tolerance = tolerances [tolerance];
+    const int solved = solve (
+      parameters, openCompressedSolution_File, test_Compress_Solution, closeCompressedSolution_File, NULL, NULL
+    );
+    FILE * const input = solved == 0 ? fopen (COMPRESSED_SOLUTION_FILENAME, "rb") : NULL;
+    struct Parameters * const read_parameters = input != NULL ? compressor_Read_Parameters (input) : NULL;
+    struct Compressor * const decompressor =
+      read_parameters != NULL ? compressor_Construct (read_parameters, NULL) : NULL;
+    if (
+         decompressor == NULL || read_parameters->space_points != COMPRESSION_SPACE_POINTS
+      || real_ToBits (read_parameters->compression_tolerance) != real_ToBits (tolerances [tolerance])
+    )
+    {
+      fprintf (stderr, "Error: couldn't read back compression case (tolerance=%g).\n", tolerances [tolerance]);
+
+      failed = 1;
+    }
+
+    size_t snapshots = 0;
+    size_t time_point = 0;
+    real_type error_max = 0.0;
+    int equal = 1;
+    while (decompressor != NULL && compressor_Read_Snapshot (decompressor, input, & time_point) == 0)
+    {
+      const real_type * const row = written_rows + snapshots * COMPRESSION_SPACE_POINTS;
+      failed |= time_point != snapshots * WRITE_EVERY_NTH_SOLUTION;
+      equal &= memcmp (decompressor->previous, row, COMPRESSION_SPACE_POINTS * sizeof (real_type)) == 0;
+      for (size_t space_point = 0; space_point < COMPRESSION_SPACE_POINTS; ++ space_point)
+      {
+        error_max = fmax (error_max, fabs (decompressor->previous [space_point] - row [space_point]));
+      }
+      ++ snapshots;
+    }
+
+    printf (
+      "Compression{method=%d;tolerance=%g;snapshots=%zu;equal=%d;error_max=%.3e;};\n",
+      METHOD, tolerances [tolerance], snapshots, equal, error_max
+    );
+    failed |= snapshots != rows || ! (error_max <= tolerances [tolerance]);
+    failed |= ! (tolerances [tolerance] > 0.0) && ! equal;
+
+    compressor_Destroy (decompressor);
+    parameters_Destroy (read_parameters);
+    if (input != NULL)
+    {
+      fclose (input);
+    }
+    free (written_rows);
+    written_rows = NULL;
+    parameters_Destroy (parameters);
+  }
+
+  /*
+   * Corrupted chunks:  0xFF nibbles claim 15 bytes per point and 0xFF varints never end.
+   */
+  unsigned char garbage [COMPRESSION_GARBAGE_BYTES];
+  real_type previous [COMPRESSION_GARBAGE_POINTS] = { 0.0 };
+  real_type current [COMPRESSION_GARBAGE_POINTS];
+  memset (garbage, 0xFF, sizeof (garbage));
+  for (size_t tolerance = 0; tolerance < sizeof (tolerances) / sizeof (tolerances [0]); ++ tolerance)
+  {
+    const int decoded = compressor_Decode_Chunk (
+      garbage, sizeof (garbage), previous, COMPRESSION_GARBAGE_POINTS, tolerances [tolerance], current
+    );
+    printf (
+      "CompressionCorrupted{method=%d;tolerance=%g;rejected=%d;};\n", METHOD, tolerances [tolerance], decoded != 0
+    );
+    failed |= decoded == 0;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+#define THROUGHPUT_SPACE_POINTS (65537)
+#define THROUGHPUT_TIME_POINTS (201)
+#define THROUGHPUT_REPEATS (5)
+#define THROUGHPUT_FRONT_WIDTH (0.05)
+#define THROUGHPUT_REFINEMENT_THRESHOLD (1.0e-3)
+
+
+/**
+ * @brief Steep front in the middle of the rod between the boundary values:  the refined kernel gets patches on both
+ * levels around it only,  as intended for local refinement.
+ */
+static real_type
+test_Front (real_type space)
+{
+  return - tanh ((space - 0.5 * TEST_SPACE_MAX) / THROUGHPUT_FRONT_WIDTH);
+}
+
+
+static size_t refined_point_updates = 0;
+
+
+/**
+ * @brief  `after_refinement'  visitor keeping the count of point updates on the refined levels.
+ */
+static int
+test_Count_Refinement (
+  const struct Parameters * parameters_, const struct Refinement * refinement, size_t time_point_
+)
+{
+  (void) parameters_;
+  (void) time_point_;
+
+  refined_point_updates = refinement->point_updates;
+
+  return 0;
+}
+
+
+/**
+ * @brief Cell updates per second of the plainest explicit stencil on this host over  `rows':  the yardstick the
+ * kernel budgets are expressed in,  so they hold across machines.
+ */
+static double
+test_Calibrate (real_type * rows)
+{
+  const double start = wallTime ();
+  for (size_t time_point = 1; time_point < THROUGHPUT_TIME_POINTS; ++ time_point)
+  {
+    const real_type * restrict const previous = rows + (time_point - 1) % 2 * THROUGHPUT_SPACE_POINTS;
+    real_type * restrict const current = rows + time_point % 2 * THROUGHPUT_SPACE_POINTS;
+    for (size_t space_point = 1; space_point < THROUGHPUT_SPACE_POINTS - 1; ++ space_point)
+    {
+      current [space_point] =
+          previous [space_point]
+        + 0.25 * (previous [space_point - 1] - 2.0 * previous [space_point] + previous [space_point + 1]);
+    }
+  }
+  const double elapsed = wallTime () - start;
+
+  /*
+   * Keeps the loop alive.
+   */
+  volatile real_type sink = rows [THROUGHPUT_SPACE_POINTS / 2];
+  (void) sink;
+
+  return (double) (THROUGHPUT_SPACE_POINTS - 2) * (double) (THROUGHPUT_TIME_POINTS - 1) / elapsed;
+}
+
+
+/**
+ * @brief Single-threaded cell updates per second of one kernel relative to  `test_Calibrate',  with the analytics
+ * compiled in as shipped;  fails below  `budget'.  The refined kernel counts the updates of its levels as well.
+ */
+static int
+test_Throughput (const char * kernel, double budget)
+{
+#ifdef WITH_OMP
+  omp_set_num_threads (1);
+#endif  // WITH_OMP
+  struct Parameters * const parameters = test_Parameters (1.0e-6, THROUGHPUT_TIME_POINTS, THROUGHPUT_SPACE_POINTS);
+  if (parameters == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for parameters.\n");
+
+    return EXIT_FAILURE;
+  }
+
+  if (strcmp (kernel, "flux") == 0)
+  {
+    parameters->diffusivity_profile = test_Diffusivity;
+    parameters->source_profile = test_Source;
+  }
+  else if (strcmp (kernel, "graded") == 0)
+  {
+    parameters->grid_grading = 0.5;
+  }
+  else if (strcmp (kernel, "refined") == 0)
+  {
+    parameters->initial_condition = test_Front;
+    parameters->refinement_levels = 2;
+    parameters->refinement_threshold = THROUGHPUT_REFINEMENT_THRESHOLD;
+  }
+  else if (strcmp (kernel, "scalar") != 0)
+  {
+    fprintf (stderr, "Error: unknown kernel (%s).\n", kernel);
+
+    parameters_Destroy (parameters);
+
+    return EXIT_FAILURE;
+  }
+
+  real_type * const rows = malloc (2 * THROUGHPUT_SPACE_POINTS * sizeof (real_type));
+  if (rows == NULL)
+  {
+    fprintf (stderr, "Error: couldn't allocate memory for calibration rows.\n");
+
+    parameters_Destroy (parameters);
+
+    return EXIT_FAILURE;
+  }
+
+  for (size_t space_point = 0; space_point < 2 * THROUGHPUT_SPACE_POINTS; ++ space_point)
+  {
+    rows [space_point] = sin ((real_type) space_point);
+  }
+
+  /*
+   * Interleaved,  best of each:  both see the same state of a shared host.
+   */
+  double baseline = 0.0;
+  double best = 0.0;
+  for (size_t repeat = 0; repeat < THROUGHPUT_REPEATS; ++ repeat)
+  {
+    const double calibrated = test_Calibrate (rows);
+    baseline = calibrated > baseline ? calibrated : baseline;
+
+    refined_point_updates = 0;
+    const double start = wallTime ();
+    const int solved = solve (parameters, NULL, NULL, NULL, NULL, test_Count_Refinement);
+    const double elapsed = wallTime () - start;
+    if (solved != 0)
+    {
+      fprintf (stderr, "Error: couldn't solve.\n");
+
+      free (rows);
+      parameters_Destroy (parameters);
+
+      return EXIT_FAILURE;
+    }
+
+    const double rate =
+      ((double) (THROUGHPUT_SPACE_POINTS - 2) * (double) (THROUGHPUT_TIME_POINTS - 1) + (double) refined_point_updates)
+      / elapsed;
+    best = rate > best ? rate : best;
+  }
+  free (rows);
+  parameters_Destroy (parameters);
+
+  const double ratio = best / baseline;
+  printf (
+    "Throughput{method=%d;kernel=%s;cell_updates_per_second=%.4e;baseline=%.4e;ratio=%.3f;budget=%.3f;};\n",
+    METHOD, kernel, best, baseline, ratio, budget
+  );
+
+  return baseline > 0.0 && ratio >= budget ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+int
+main (int argc, char * argv [])
+{
+  if (argc == 2 && strcmp (argv [1], "convergence-space") == 0)
+  {
+    return test_Convergence_Space (0.0);
+  }
+  else if (argc == 2 && strcmp (argv [1], "convergence-graded") == 0)
+  {
+    return test_Convergence_Space (CONVERGENCE_GRID_GRADING);
+  }
+  else if (argc == 2 && strcmp (argv [1], "convergence-time") == 0)
+  {
+    return test_Convergence_Time ();
+  }
+  else if (argc == 2 && strcmp (argv [1], "determinism") == 0)
+  {
+    return test_Determinism ();
+  }
+  else if (argc == 2 && strcmp (argv [1], "refinement") == 0)
+  {
+    return test_Refinement ();
+  }
+  else if (argc == 2 && strcmp (argv [1], "steady-state") == 0)
+  {
+    return test_Steady_State ();
+  }
+  else if (argc == 2 && strcmp (argv [1], "heat-flux") == 0)
+  {
+    return test_Heat_Flux ();
+  }
+  else if (argc == 2 && strcmp (argv [1], "compression") == 0)
+  {
+    return test_Compression ();
+  }
+  else if (argc == 4 && strcmp (argv [1], "throughput") == 0)
+  {
+    return test_Throughput (argv [2], strtod (argv [3], NULL));
+  }
+
+  fprintf (
+    stderr,
+    "Usage: %s convergence-space | convergence-graded | convergence-time | determinism | refinement | steady-state | heat-flux | compression | throughput <scalar|flux|graded|refined> <budget>\n",
+    argc > 0 ? argv [0] : "regression"
+  );
+
+  return EXIT_FAILURE;
+}